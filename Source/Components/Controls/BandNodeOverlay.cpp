@@ -0,0 +1,223 @@
+
+#include "BandNodeOverlay.h"
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+
+//==============================================================================
+/** Every band's eq thumb across the response curve, hit tested and drawn from one array. Param changes only store values and flag the
+    node, the next frame places it and repaints where it was and where it is
+*/
+BandNodeOverlay::BandNodeOverlay(SemiProQAudioProcessor& p, SemiProQAudioProcessorEditor& e) : audioProcessor(p), editor(e) {
+    setInterceptsMouseClicks(true, false);
+    for (int i = 0; i < MAX_FILTERS; ++i) {
+        const int base = i * PARAMS_PER_FILTER;
+        audioProcessor.tree.addParameterListener(params[FREQ + base], this);
+        audioProcessor.tree.addParameterListener(params[GAIN + base], this);
+        audioProcessor.tree.addParameterListener(params[BYPASS + base], this);
+        freqParams[i] = audioProcessor.tree.getParameter(params[FREQ + base]);
+        gainParams[i] = audioProcessor.tree.getParameter(params[GAIN + base]);
+        freqs[i].store(*audioProcessor.tree.getRawParameterValue(params[FREQ + base]));
+        gains[i].store(*audioProcessor.tree.getRawParameterValue(params[GAIN + base]));
+        bypasses[i].store(*audioProcessor.tree.getRawParameterValue(params[BYPASS + base]) >= 0.5f);
+    }
+}
+
+BandNodeOverlay::~BandNodeOverlay() {
+    for (int i = 0; i < MAX_FILTERS; ++i) {
+        const int base = i * PARAMS_PER_FILTER;
+        audioProcessor.tree.removeParameterListener(params[FREQ + base], this);
+        audioProcessor.tree.removeParameterListener(params[GAIN + base], this);
+        audioProcessor.tree.removeParameterListener(params[BYPASS + base], this);
+    }
+}
+
+void BandNodeOverlay::setNodeColour(int i, juce::Colour c) {
+    nodes[i].colour = c;
+    queuedDirty = queuedDirty.getUnion(getNodeBounds(nodes[i]));
+}
+
+void BandNodeOverlay::setNodeActive(int i, bool active) {
+    //old circle goes away with the hide, new one is placed from params on the show
+    queuedDirty = queuedDirty.getUnion(getNodeBounds(nodes[i]));
+    nodes[i].active = active;
+    if (active) {
+        queuedDirty = queuedDirty.getUnion(placeFromParams(i));
+    }
+}
+
+void BandNodeOverlay::placeNode(int i, juce::Point<int> pos) {
+    freqParams[i]->beginChangeGesture();
+    gainParams[i]->beginChangeGesture();
+    setParamsFromPosition(i, pos);
+    freqParams[i]->endChangeGesture();
+    gainParams[i]->endChangeGesture();
+}
+
+juce::Rectangle<int> BandNodeOverlay::frameCallback() {
+    auto dirty = queuedDirty;
+    queuedDirty = {};
+    const auto changed = pending.exchange(0);
+    for (int i = 0; i < MAX_FILTERS; ++i) {
+        if (changed & (1u << i)) {
+            dirty = dirty.getUnion(placeFromParams(i));
+        }
+    }
+    //the outline moves from the old selection to the new one
+    const int selected = editor.selectedFilterValue.getValue();
+    if (selected != drawnSelected) {
+        if (drawnSelected >= 0 && drawnSelected < MAX_FILTERS) {
+            dirty = dirty.getUnion(getNodeBounds(nodes[drawnSelected]));
+        }
+        if (selected >= 0 && selected < MAX_FILTERS) {
+            dirty = dirty.getUnion(getNodeBounds(nodes[selected]));
+        }
+        drawnSelected = selected;
+    }
+    return dirty;
+}
+
+//later bands on top, same as the order they're hit tested in reverse
+void BandNodeOverlay::paint(juce::Graphics& g) {
+    const auto clip = g.getClipBounds();
+    for (int i = 0; i < MAX_FILTERS; ++i) {
+        const auto& node = nodes[i];
+        const auto bounds = getNodeBounds(node);
+        if (bounds.isEmpty() || !bounds.intersects(clip)) {
+            continue;
+        }
+        //fill ellipse with color based on bypassed state
+        g.setColour(node.bypassed ? juce::Colours::grey : node.colour);
+        g.fillEllipse(bounds.toFloat());
+        //if selected, draw white outline
+        if (i == drawnSelected) {
+            g.setColour(juce::Colours::white);
+            g.drawEllipse(bounds.toFloat().reduced(1.0f), 2.0f);
+        }
+    }
+}
+
+//area changed, so every shown node moves with it
+void BandNodeOverlay::resized() {
+    for (int i = 0; i < MAX_FILTERS; ++i) {
+        if (nodes[i].active) {
+            placeFromParams(i);
+        }
+    }
+}
+
+bool BandNodeOverlay::hitTest(int x, int y) {
+    return nodeAt({ x, y }) >= 0;
+}
+
+void BandNodeOverlay::mouseDown(const juce::MouseEvent& event) {
+    const int i = nodeAt(event.getPosition());
+    if (i < 0) {
+        return;
+    }
+    //if left click, select this eq and open one gesture for freq and gain that lasts the whole drag
+    if (event.mods.isLeftButtonDown()) {
+        editor.selectedFilterValue = i;
+        dragging = i;
+        dragOffset = nodes[i].centre - event.getPosition();
+        freqParams[i]->beginChangeGesture();
+        gainParams[i]->beginChangeGesture();
+    }
+    //if right click, delete node and reset filter
+    else if (event.mods.isRightButtonDown()) {
+        editor.buttonReset(i);
+    }
+}
+
+//keeps the node where it was grabbed and inside the render area. the move shows on the next frame, from the params it set
+void BandNodeOverlay::mouseDrag(const juce::MouseEvent& event) {
+    if (dragging < 0) {
+        return;
+    }
+    const auto area = getNodeArea();
+    const auto pos = event.getPosition() + dragOffset;
+    setParamsFromPosition(dragging, { juce::jlimit(area.getX(), area.getRight(), pos.x), juce::jlimit(area.getY(), area.getBottom(), pos.y) });
+}
+
+void BandNodeOverlay::mouseUp(const juce::MouseEvent&) {
+    if (dragging < 0) {
+        return;
+    }
+    freqParams[dragging]->endChangeGesture();
+    gainParams[dragging]->endChangeGesture();
+    dragging = -1;
+}
+
+//built when the tooltip window asks, from cached vals
+juce::String BandNodeOverlay::getTooltip() {
+    const int i = nodeAt(getMouseXYRelative());
+    if (i < 0) {
+        return {};
+    }
+    return formatFrequency(freqs[i].load()) + ", " + formatGain(gains[i].load());
+}
+
+//only change on gain, freq or bypass here. ids start with the band number
+void BandNodeOverlay::parameterChanged(const juce::String& paramID, float newValue) {
+    const int i = paramID.getIntValue() - 1;
+    if (i < 0 || i >= MAX_FILTERS) {
+        return;
+    }
+    const int base = i * PARAMS_PER_FILTER;
+    if (paramID == params[FREQ + base]) {
+        freqs[i].store(newValue);
+    }
+    else if (paramID == params[GAIN + base]) {
+        gains[i].store(newValue);
+    }
+    else if (paramID == params[BYPASS + base]) {
+        bypasses[i].store(newValue >= 0.5f);
+    }
+    pending.fetch_or(1u << i);
+}
+
+int BandNodeOverlay::nodeAt(juce::Point<int> pos) const {
+    for (int i = MAX_FILTERS - 1; i >= 0; --i) {
+        const auto bounds = getNodeBounds(nodes[i]);
+        if (!bounds.isEmpty() && bounds.getCentre().getDistanceFrom(pos) <= DRAG_BUTTON_DIM / 2.0f) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+//overlay is the render area grown by a node's radius, so nodes on its edges are still whole
+juce::Rectangle<int> BandNodeOverlay::getNodeArea() const {
+    return getLocalBounds().reduced(DRAG_BUTTON_DIM / 2);
+}
+
+juce::Rectangle<int> BandNodeOverlay::getNodeBounds(const Node& node) const {
+    if (!node.active) {
+        return {};
+    }
+    return juce::Rectangle<int>(DRAG_BUTTON_DIM, DRAG_BUTTON_DIM).withCentre(node.centre);
+}
+
+juce::Rectangle<int> BandNodeOverlay::placeFromParams(int i) {
+    auto& node = nodes[i];
+    const auto before = getNodeBounds(node);
+    const bool wasBypassed = node.bypassed;
+    //x from the logRange 0-1 value, gain is linear so it maps straight onto the height
+    const auto area = getNodeArea();
+    node.centre = { area.getX() + (int)(freqRange.convertTo0to1(freqs[i].load()) * area.getWidth()),
+                    (int)juce::jmap(gains[i].load(), MIN_DB, MAX_DB, (float)area.getBottom(), (float)area.getY()) };
+    node.bypassed = bypasses[i].load();
+    const auto after = getNodeBounds(node);
+    if (before == after && wasBypassed == node.bypassed) {
+        return {};
+    }
+    return before.getUnion(after);
+}
+
+void BandNodeOverlay::setParamsFromPosition(int i, juce::Point<int> pos) {
+    //pixel space to 0-1, freq param is already log skewed and gain is linear, so only gain needs inverting
+    const auto area = getNodeArea();
+    const float xNorm = (pos.x - area.getX()) / float(area.getWidth());
+    const float yNorm = (pos.y - area.getY()) / float(area.getHeight());
+    freqParams[i]->setValueNotifyingHost(juce::jlimit(0.0f, 1.0f, xNorm));
+    gainParams[i]->setValueNotifyingHost(juce::jlimit(0.0f, 1.0f, 1.0f - yNorm));
+}
@@ -0,0 +1,72 @@
+
+#pragma once
+#include <JuceHeader.h>
+#include "Utils/Constants.h"
+
+class SemiProQAudioProcessor;
+class SemiProQAudioProcessorEditor;
+
+//==============================================================================
+/** One component for every band's node, to select and adjust parameters without needing sliders
+*/
+struct BandNodeOverlay : juce::Component, juce::TooltipClient, juce::AudioProcessorValueTreeState::Listener {
+    BandNodeOverlay(SemiProQAudioProcessor&, SemiProQAudioProcessorEditor&);
+    ~BandNodeOverlay() override;
+
+    void setNodeColour(int i, juce::Colour c);
+    //shows or hides node i, placed from its current params
+    void setNodeActive(int i, bool active);
+    bool isNodeActive(int i) const {
+        return nodes[i].active;
+    }
+    //sets node i's freq and gain from a position in this component's coords, as one gesture
+    void placeNode(int i, juce::Point<int> pos);
+    //places nodes whose params changed and returns the area they and any selection change covered, empty if nothing did
+    juce::Rectangle<int> frameCallback();
+
+private:
+    //what's drawn for one node, only touched on the message thread
+    struct Node {
+        juce::Point<int> centre;
+        juce::Colour colour;
+        bool active = false;
+        bool bypassed = false;
+    };
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+    //only over a node, so clicks anywhere else fall through to the editor
+    bool hitTest(int x, int y) override;
+    //select and start a drag on left, delete on right
+    void mouseDown(const juce::MouseEvent& event) override;
+    void mouseDrag(const juce::MouseEvent& event) override;
+    void mouseUp(const juce::MouseEvent& event) override;
+    juce::String getTooltip() override;
+    //callback from slider, automation, or node changes, on whatever thread made them
+    void parameterChanged(const juce::String& paramID, float newValue) override;
+    //topmost node under pos, -1 if none
+    int nodeAt(juce::Point<int> pos) const;
+    //area nodes can be placed in, the editor's render area
+    juce::Rectangle<int> getNodeArea() const;
+    //circle of a node, empty while it's hidden
+    juce::Rectangle<int> getNodeBounds(const Node& node) const;
+    //moves node i to where its cached params put it and returns the area that touched
+    juce::Rectangle<int> placeFromParams(int i);
+    void setParamsFromPosition(int i, juce::Point<int> pos);
+
+    SemiProQAudioProcessor& audioProcessor;
+    SemiProQAudioProcessorEditor& editor;
+    Node nodes[MAX_FILTERS];
+    juce::RangedAudioParameter* freqParams[MAX_FILTERS] = {};
+    juce::RangedAudioParameter* gainParams[MAX_FILTERS] = {};
+    //latest values from the listener, and a bit per node that changed since the last frame
+    std::atomic<float> freqs[MAX_FILTERS], gains[MAX_FILTERS];
+    std::atomic<bool> bypasses[MAX_FILTERS];
+    std::atomic<juce::uint32> pending{ 0 };
+    //area message thread changes touched since the last frame
+    juce::Rectangle<int> queuedDirty;
+    int drawnSelected = -1;
+    //node being dragged and where it was grabbed from its centre
+    int dragging = -1;
+    juce::Point<int> dragOffset;
+};
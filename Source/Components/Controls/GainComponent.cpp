@@ -27,21 +27,25 @@ GainComponent::~GainComponent() {}
 
 void GainComponent::paint(juce::Graphics& g) {
     if (!isMin) {
-        auto bounds = getLocalBounds().toFloat();
-        g.setColour(juce::Colours::grey);
-        g.fillRoundedRectangle(bounds, CORNER_SIZE);
+        chrome.draw(g, *this, [this](juce::Graphics& cg) { paintChrome(cg); });
+    }
+}
 
-        auto midX = bounds.getX() + (bounds.getWidth() / 2);
-        g.setColour(juce::Colours::black);
-        g.fillRect(midX, bounds.getY(), DIV_LINE_WIDTH, bounds.getHeight());
+void GainComponent::paintChrome(juce::Graphics& g) {
+    auto bounds = getLocalBounds().toFloat();
+    g.setColour(juce::Colours::grey);
+    g.fillRoundedRectangle(bounds, CORNER_SIZE);
 
-        componentLabel.paintAll(g);
-        preGainLabel.paintAll(g);
-        postGainLabel.paintAll(g);
+    auto midX = bounds.getX() + (bounds.getWidth() / 2);
+    g.setColour(juce::Colours::black);
+    g.fillRect(midX, bounds.getY(), DIV_LINE_WIDTH, bounds.getHeight());
 
-        g.setColour(juce::Colours::white);
-        g.drawRoundedRectangle(bounds, CORNER_SIZE, 2.0f);
-    }
+    componentLabel.paintAll(g);
+    preGainLabel.paintAll(g);
+    postGainLabel.paintAll(g);
+
+    g.setColour(juce::Colours::white);
+    g.drawRoundedRectangle(bounds, CORNER_SIZE, 2.0f);
 }
 
 void GainComponent::resized() {
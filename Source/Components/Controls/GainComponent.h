@@ -16,6 +16,8 @@ struct GainComponent : public MinimizableComponent {
 
 private:
     void paint(juce::Graphics& g) override;
+    //everything paint shows, rendered into the chrome layer
+    void paintChrome(juce::Graphics& g);
     void resized() override;
     //helpers to clean up constructor and resized
     void makeSlider(juce::Slider& slider);
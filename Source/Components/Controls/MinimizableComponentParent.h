@@ -4,6 +4,7 @@
 #include <JuceHeader.h>
 #include "CustomLookAndFeel.h"
 #include "Utils/Constants.h"
+#include "Utils/ChromeLayer.h"
 
 //handles the consistent minimize/expand operations and the drag functions
 struct MinimizableComponent : public juce::Component {
@@ -68,6 +69,8 @@ struct MinimizableComponent : public juce::Component {
     juce::TextButton minButton;
     //drag functionality
     juce::ComponentDragger dragger;
+    //background, div lines, and labels, only redrawn on resize or a scale change. Moving the component just blits it somewhere else
+    ChromeLayer chrome;
 };
 
 //replaces all the juce labels in minimize comps. Way cheaper, easier to paint, and doesn't give issues with dragging
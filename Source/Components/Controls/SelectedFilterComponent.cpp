@@ -5,7 +5,7 @@
 #include "CustomLookAndFeel.h"
 
 //==============================================================================
-/** Selected Filter component: when the draggable button is selected, all of its parameters show up here, god bless juce for slider attachments
+/** Selected Filter component: when a band node is selected, all of its parameters show up here, god bless juce for slider attachments
 */
 SelectedFilterComponent::SelectedFilterComponent(SemiProQAudioProcessor& p, SemiProQAudioProcessorEditor& e, int id, int type, CustomLookAndFeelB& lnfb, CustomLookAndFeelD& lnfd)
                                            : MinimizableComponent(lnfd, SELECTED_SIZE_X, SELECTED_SIZE_Y, SELECTED_TOPLEFT_X, SELECTED_TOPLEFT_Y), 
@@ -15,7 +15,7 @@ SelectedFilterComponent::SelectedFilterComponent(SemiProQAudioProcessor& p, Semi
     componentLabel.setText("SELECTED FILTER");
     freqLabel.setText("FREQ");
     gainLabel.setText("GAIN");
-    auto qText = (currFilterType == HIGHPASS_OCT || currFilterType == LOWPASS_OCT) ? "DB/OCTAVE" : "Q";
+    auto qText = isSlopeType(currFilterType) ? "DB/OCTAVE" : "Q";
     qualityLabel.setText(qText);
     typeLabel.setText("TYPE");
     bypassLabel.setText("BYPASS");
@@ -29,7 +29,7 @@ SelectedFilterComponent::SelectedFilterComponent(SemiProQAudioProcessor& p, Semi
     //combo box setup
     addAndMakeVisible(typeComboBox);
     //value ids are plus 1 since item value id can't be 0
-    for (int i = PEAK; i <= NOTCH; ++i) {
+    for (int i = PEAK; i <= CROSSOVER; ++i) {
         typeComboBox.addItem(filterTypes[i], i + 1);
     }
 
@@ -74,7 +74,7 @@ void SelectedFilterComponent::updateFilterAndSliders(int id) {
 
     freqSliderAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(audioProcessor.tree, params[FREQ + currFilter * PARAMS_PER_FILTER], freqSlider);
     gainSliderAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(audioProcessor.tree, params[GAIN + currFilter * PARAMS_PER_FILTER], gainSlider);
-    (currFilterType == HIGHPASS_OCT || currFilterType == LOWPASS_OCT) ? swapQualitySlider(B_WORTH, "DB/OCTAVE") : swapQualitySlider(QUALITY, "Q");
+    isSlopeType(currFilterType) ? swapQualitySlider(B_WORTH, "DB/OCTAVE") : swapQualitySlider(QUALITY, "Q");
     typeBoxAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(audioProcessor.tree, params[TYPE + currFilter * PARAMS_PER_FILTER], typeComboBox);
     bypassButtonAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(audioProcessor.tree, params[BYPASS + currFilter * PARAMS_PER_FILTER], bypassButton);
     deleteButton.setToggleState(false, juce::NotificationType::dontSendNotification);
@@ -84,42 +84,52 @@ void SelectedFilterComponent::updateFilterAndSliders(int id) {
 
 void SelectedFilterComponent::paint(juce::Graphics& g) {
     if (!isMin && currFilter != -1) {
-        //background
-        auto bounds = getLocalBounds().toFloat();
-        g.setColour(juce::Colours::grey);
-        g.fillRoundedRectangle(bounds, CORNER_SIZE);
-
-        //div lines
-        auto third = bounds.getWidth() / 3;
-        auto x = bounds.getX();
-        g.setColour(juce::Colours::black);
-        g.fillRect(x + third - 1, bounds.getY(), DIV_LINE_WIDTH, bounds.getHeight());
-        g.fillRect(x + third + third - 1, bounds.getY(), DIV_LINE_WIDTH, bounds.getHeight());
-
-        //labels and filter color
-        componentLabel.paint(g);
-        freqLabel.paint(g);
-        gainLabel.paint(g);
-        qualityLabel.paint(g);
-        typeLabel.paint(g);
-        bypassLabel.paint(g);
-        deleteLabel.paint(g);
+        if (chromeStale.exchange(false)) {
+            chrome.invalidate();
+        }
+        chrome.draw(g, *this, [this](juce::Graphics& cg) { paintChrome(cg); });
+        //filter color changes with the selection, so it goes on top live with the outline it sits under
         selectedColor.setColour(editor.getColour(currFilter));
         selectedColor.paint(g);
         componentLabel.paintOutline(g);
-        freqLabel.paintOutline(g);
-        gainLabel.paintOutline(g);
-        qualityLabel.paintOutline(g);
-        typeLabel.paintOutline(g);
-        bypassLabel.paintOutline(g);
-        deleteLabel.paintOutline(g);
-
-        //outline
-        g.setColour(juce::Colours::white);
-        g.drawRoundedRectangle(bounds, CORNER_SIZE, 2.0f);
     }
 }
 
+//everything but the filter color
+void SelectedFilterComponent::paintChrome(juce::Graphics& g) {
+    //background
+    auto bounds = getLocalBounds().toFloat();
+    g.setColour(juce::Colours::grey);
+    g.fillRoundedRectangle(bounds, CORNER_SIZE);
+
+    //div lines
+    auto third = bounds.getWidth() / 3;
+    auto x = bounds.getX();
+    g.setColour(juce::Colours::black);
+    g.fillRect(x + third - 1, bounds.getY(), DIV_LINE_WIDTH, bounds.getHeight());
+    g.fillRect(x + third + third - 1, bounds.getY(), DIV_LINE_WIDTH, bounds.getHeight());
+
+    //labels
+    componentLabel.paint(g);
+    freqLabel.paint(g);
+    gainLabel.paint(g);
+    qualityLabel.paint(g);
+    typeLabel.paint(g);
+    bypassLabel.paint(g);
+    deleteLabel.paint(g);
+    componentLabel.paintOutline(g);
+    freqLabel.paintOutline(g);
+    gainLabel.paintOutline(g);
+    qualityLabel.paintOutline(g);
+    typeLabel.paintOutline(g);
+    bypassLabel.paintOutline(g);
+    deleteLabel.paintOutline(g);
+
+    //outline
+    g.setColour(juce::Colours::white);
+    g.drawRoundedRectangle(bounds, CORNER_SIZE, 2.0f);
+}
+
 void SelectedFilterComponent::resized() {
     auto bounds = getLocalBounds();
     if (isMin) {
@@ -163,17 +173,18 @@ void SelectedFilterComponent::resized() {
 
 void SelectedFilterComponent::parameterChanged(const juce::String& paramID, float newValue) {
     //swap q slider if type changes from q to dB/oct 
-    if ((newValue == HIGHPASS_OCT || newValue == LOWPASS_OCT) && currFilterType != HIGHPASS_OCT && currFilterType != LOWPASS_OCT) {
+    const int newType = static_cast<int>(newValue);
+    if (isSlopeType(newType) && !isSlopeType(currFilterType)) {
         swapQualitySlider(B_WORTH, "DB/OCTAVE");
         //sets q value to 1.0f, update takes a 0-1, so it looks confusing. 
         audioProcessor.updateParameter(currFilter, QUALITY, 0.1f);
     }
-    else if (newValue != HIGHPASS_OCT && newValue != LOWPASS_OCT && (currFilterType == HIGHPASS_OCT || currFilterType == LOWPASS_OCT)) {
+    else if (!isSlopeType(newType) && isSlopeType(currFilterType)) {
         swapQualitySlider(QUALITY, "Q");
         //reset db/oct value
         audioProcessor.updateParameter(currFilter, B_WORTH, 0);
     }
-    currFilterType = newValue;
+    currFilterType = newType;
 }
 
 void SelectedFilterComponent::makeSlider(juce::Slider& slider, int w) {
@@ -187,6 +198,13 @@ void SelectedFilterComponent::makeSlider(juce::Slider& slider, int w) {
 void SelectedFilterComponent::swapQualitySlider(int type, juce::String text) {
     qualitySliderAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(audioProcessor.tree, params[type + currFilter * PARAMS_PER_FILTER], qualitySlider);
     qualityLabel.setText(text);
+    //the label is part of the chrome. automation can land here off the message thread, so paint picks the flag up
+    chromeStale.store(true);
+    juce::MessageManager::callAsync([safe = juce::Component::SafePointer<SelectedFilterComponent>(this)]() {
+        if (safe != nullptr) {
+            safe->repaint();
+        }
+    });
 }
 
 void SelectedFilterComponent::makeResizedSection(CheapLabel& l, juce::Component& c, juce::Rectangle<int> r) {
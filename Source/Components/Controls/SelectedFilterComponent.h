@@ -10,7 +10,7 @@ class SemiProQAudioProcessorEditor;
 class CustomLookAndFeelB;
 class CustomLookAndFeelD;
 
-//color box in top left corner of component to match selected filter draggable button color
+//color box in top left corner of component to match selected filter band node color
 struct ColorIndicator {
 public:
     void setColour(juce::Colour c) { colour = c; }
@@ -41,6 +41,8 @@ struct SelectedFilterComponent : public MinimizableComponent, juce::AudioProcess
 private:
     //component update callbacks
     void paint(juce::Graphics& g) override;
+    //everything paint shows but the filter color, rendered into the chrome layer
+    void paintChrome(juce::Graphics& g);
     void resized() override;
     //callback for currEq type change, to swap q and db/oct
     void parameterChanged(const juce::String& paramID, float newValue) override;
@@ -76,4 +78,6 @@ private:
 
     ColorIndicator selectedColor;
     CheapLabel freqLabel, gainLabel, qualityLabel, typeLabel, bypassLabel, deleteLabel, componentLabel;
+    //set when the q label text swaps, the chrome is rendered again on the next paint
+    std::atomic<bool> chromeStale{ false };
 };
@@ -8,6 +8,7 @@
 SettingsComponent::SettingsComponent(SemiProQAudioProcessor& p, SemiProQAudioProcessorEditor& e, CustomLookAndFeelC& lnfc, CustomLookAndFeelD& lnfd, CustomLookAndFeelE& lnfe)
                                    : MinimizableComponent(lnfd, SETTINGS_SIZE_X, SETTINGS_SIZE_Y, SETTINGS_TOPLEFT_X, SETTINGS_TOPLEFT_Y),audioProcessor(p), editor(e) {
     analyserSettingsLabel.setText("ANALYSER");
+    curveSettingsLabel.setText("CURVE");
     peakSettingsLabel.setText("PEAK");
     componentLabel.setText("SETTINGS");
     blankLabel.setText("");
@@ -15,9 +16,60 @@ SettingsComponent::SettingsComponent(SemiProQAudioProcessor& p, SemiProQAudioPro
     analyserOnButton.setComponentID("power");
     addAndMakeVisible(analyserOnButton);
 
-    analyserModeButton.setClickingTogglesState(true);
+    //cycles PRE, POST, BOTH, DELTA
     analyserModeButton.setLookAndFeel(&lnfc);
     addAndMakeVisible(analyserModeButton);
+    analyserModeButton.onClick = [this]() {
+        int mode = editor.analyserModeValue.getValue();
+        editor.analyserModeValue = (mode + 1) % ANALYSER_MODE_AMT;
+    };
+    //spectrogram toggle, lit while on
+    spectrogramButton.setButtonText("SPEC");
+    spectrogramButton.setClickingTogglesState(true);
+    spectrogramButton.setColour(juce::TextButton::buttonColourId, juce::Colours::darkgrey);
+    spectrogramButton.setColour(juce::TextButton::buttonOnColourId, juce::Colours::cyan);
+    spectrogramButton.setLookAndFeel(&lnfc);
+    addAndMakeVisible(spectrogramButton);
+
+    //gradient under the traces, same toggle colours
+    fillButton.setButtonText("FILL");
+    fillButton.setClickingTogglesState(true);
+    fillButton.setColour(juce::TextButton::buttonColourId, juce::Colours::darkgrey);
+    fillButton.setColour(juce::TextButton::buttonOnColourId, juce::Colours::cyan);
+    fillButton.setLookAndFeel(&lnfc);
+    addAndMakeVisible(fillButton);
+
+    //cycles LIVE, MAX, AVG, INT. re-selecting a mode starts its hold over
+    analyserAverageButton.setLookAndFeel(&lnfc);
+    addAndMakeVisible(analyserAverageButton);
+    analyserAverageButton.onClick = [this]() {
+        int average = editor.analyserAverageValue.getValue();
+        editor.analyserAverageValue = (average + 1) % ANALYSER_AVG_AMT;
+    };
+
+    //cycles RAW, 1/24, 1/12, 1/6, 1/3, 1/1 octave
+    analyserSmoothingButton.setLookAndFeel(&lnfc);
+    addAndMakeVisible(analyserSmoothingButton);
+    analyserSmoothingButton.onClick = [this]() {
+        int smoothing = editor.analyserSmoothingValue.getValue();
+        editor.analyserSmoothingValue = (smoothing + 1) % ANALYSER_SMOOTH_AMT;
+    };
+
+    //cycles MAG, PHASE, DELAY, PH+GD traces over the response curve
+    curveTracesButton.setLookAndFeel(&lnfc);
+    addAndMakeVisible(curveTracesButton);
+    curveTracesButton.onClick = [this]() {
+        int mode = editor.curveTracesValue.getValue();
+        editor.curveTracesValue = (mode + 1) % CURVE_TRACES_AMT;
+    };
+
+    //cycles MID, SIDE, L, R, L+R
+    analyserChannelButton.setLookAndFeel(&lnfc);
+    addAndMakeVisible(analyserChannelButton);
+    analyserChannelButton.onClick = [this]() {
+        int channel = editor.analyserChannelValue.getValue();
+        editor.analyserChannelValue = (channel + 1) % ANALYSER_CHANNEL_AMT;
+    };
 
     peakOnButton.setComponentID("power");
     addAndMakeVisible(peakOnButton);
@@ -26,6 +78,14 @@ SettingsComponent::SettingsComponent(SemiProQAudioProcessor& p, SemiProQAudioPro
     peakModeButton.setLookAndFeel(&lnfc);
     addAndMakeVisible(peakModeButton);
 
+    //cycles L, M, S editor sizes
+    uiScaleButton.setLookAndFeel(&lnfc);
+    addAndMakeVisible(uiScaleButton);
+    uiScaleButton.onClick = [this]() {
+        int mode = editor.uiScaleValue.getValue();
+        editor.uiScaleValue = (mode + 1) % UI_SCALE_AMT;
+    };
+
     resetTopLeftProps();
     applyMinimized(*this, editor.minSettings.getValue());
     addAndMakeVisible(minButton);
@@ -36,42 +96,64 @@ SettingsComponent::SettingsComponent(SemiProQAudioProcessor& p, SemiProQAudioPro
 
 SettingsComponent::~SettingsComponent() {
     analyserModeButton.setLookAndFeel(nullptr);
+    analyserChannelButton.setLookAndFeel(nullptr);
+    spectrogramButton.setLookAndFeel(nullptr);
+    fillButton.setLookAndFeel(nullptr);
+    analyserAverageButton.setLookAndFeel(nullptr);
+    analyserSmoothingButton.setLookAndFeel(nullptr);
+    curveTracesButton.setLookAndFeel(nullptr);
     peakModeButton.setLookAndFeel(nullptr);
+    uiScaleButton.setLookAndFeel(nullptr);
     helpButton.setLookAndFeel(nullptr);
     creditsButton.setLookAndFeel(nullptr);
 }
 
 void SettingsComponent::paint(juce::Graphics& g) {
     if (!isMin) {
-        auto bounds = getLocalBounds().toFloat();
-        g.setColour(juce::Colours::grey);
-        g.fillRoundedRectangle(bounds, CORNER_SIZE);
-        auto midX = bounds.getX() + (bounds.getWidth() / 3);
-        g.setColour(juce::Colours::black);
-        g.fillRect(midX, bounds.getY(), DIV_LINE_WIDTH, bounds.getHeight());
-        g.fillRect(midX + bounds.getWidth() / 3 - 1, bounds.getY(), DIV_LINE_WIDTH, bounds.getHeight());
-
-        analyserSettingsLabel.paintAll(g);
-        peakSettingsLabel.paintAll(g);
-        componentLabel.paintAll(g);
-        blankLabel.paintAll(g);
-
-        g.setColour(juce::Colours::white);
-        g.drawRoundedRectangle(bounds, CORNER_SIZE, 2.0f);
+        chrome.draw(g, *this, [this](juce::Graphics& cg) { paintChrome(cg); });
     }
 }
 
+void SettingsComponent::paintChrome(juce::Graphics& g) {
+    auto bounds = getLocalBounds().toFloat();
+    g.setColour(juce::Colours::grey);
+    g.fillRoundedRectangle(bounds, CORNER_SIZE);
+    //analyser takes the left half, curve over peak and size/help/credits a quarter each
+    auto midX = bounds.getX() + (bounds.getWidth() / 2);
+    g.setColour(juce::Colours::black);
+    g.fillRect(midX, bounds.getY(), DIV_LINE_WIDTH, bounds.getHeight());
+    g.fillRect(midX + bounds.getWidth() / 4 - 1, bounds.getY(), DIV_LINE_WIDTH, bounds.getHeight());
+    g.fillRect(midX, (float)peakArea.getY() - 1.0f, bounds.getWidth() / 4, DIV_LINE_WIDTH);
+
+    analyserSettingsLabel.paintAll(g);
+    curveSettingsLabel.paintAll(g);
+    peakSettingsLabel.paintAll(g);
+    componentLabel.paintAll(g);
+    blankLabel.paintAll(g);
+
+    g.setColour(juce::Colours::white);
+    g.drawRoundedRectangle(bounds, CORNER_SIZE, 2.0f);
+}
+
 void SettingsComponent::resized() {
     auto bounds = getLocalBounds();
     if (isMin) {
         analyserSettingsLabel.setBounds(0, 0, 0, 0);
+        curveSettingsLabel.setBounds(0, 0, 0, 0);
         peakSettingsLabel.setBounds(0, 0, 0, 0);
         componentLabel.setBounds(0, 0, 0, 0);
         blankLabel.setBounds(0, 0, 0, 0);
         analyserOnButton.setBounds(0, 0, 0, 0);
         analyserModeButton.setBounds(0, 0, 0, 0);
+        analyserChannelButton.setBounds(0, 0, 0, 0);
+        spectrogramButton.setBounds(0, 0, 0, 0);
+        fillButton.setBounds(0, 0, 0, 0);
+        analyserAverageButton.setBounds(0, 0, 0, 0);
+        analyserSmoothingButton.setBounds(0, 0, 0, 0);
+        curveTracesButton.setBounds(0, 0, 0, 0);
         peakOnButton.setBounds(0, 0, 0, 0);
         peakModeButton.setBounds(0, 0, 0, 0);
+        uiScaleButton.setBounds(0, 0, 0, 0);
         creditsButton.setBounds(0, 0, 0, 0);
         helpButton.setBounds(0, 0, 0, 0);
         minButton.setTopLeftPosition(bounds.getX(), bounds.getY());
@@ -82,27 +164,89 @@ void SettingsComponent::resized() {
         componentLabel.setBounds(minBounds);
         minButton.setBounds(minBounds.removeFromRight(MINIMIZE_BUTTON_DIM));
 
-        makeResizedSection(analyserSettingsLabel, analyserOnButton, analyserModeButton, bounds.removeFromLeft(getWidth() / 3));
-        makeResizedSection(blankLabel, helpButton, creditsButton, bounds.removeFromRight(getWidth() / 3));
-        makeResizedSection(peakSettingsLabel, peakOnButton, peakModeButton, bounds);
+        //analyser takes the left half in three rows, so no button is narrower than its longest text (PH+GD, DELTA, 1/24 at 16pt bold)
+        makeSection(analyserSettingsLabel, bounds.removeFromLeft(getWidth() / 2),
+                    { { &analyserOnButton, &spectrogramButton, &fillButton },
+                      { &analyserModeButton, &analyserChannelButton },
+                      { &analyserAverageButton, &analyserSmoothingButton } });
+        //window size, help, and credits down the right quarter
+        makeSection(blankLabel, bounds.removeFromRight(getWidth() / 4), { { &uiScaleButton }, { &helpButton }, { &creditsButton } });
+        //curve traces over peak power and mode in the quarter between, every row the same height
+        const int rowHeight = (bounds.getHeight() - 2 * LABEL_HEIGHT) / 3;
+        makeSection(curveSettingsLabel, bounds.removeFromTop(LABEL_HEIGHT + rowHeight), { { &curveTracesButton } });
+        peakArea = bounds;
+        makeSection(peakSettingsLabel, bounds, { { &peakOnButton }, { &peakModeButton } });
     }
 }
 
 void SettingsComponent::referValuesToButtons(juce::Value& v) {
     MinimizableComponent::referValuesToButtons(v);
     analyserOnButton.getToggleStateValue().referTo(editor.analyserOnValue);
-    analyserModeButton.getToggleStateValue().referTo(editor.analyserModeValue);
+    spectrogramButton.getToggleStateValue().referTo(editor.spectrogramOnValue);
+    fillButton.getToggleStateValue().referTo(editor.analyserFillValue);
     peakOnButton.getToggleStateValue().referTo(editor.peakOnValue);
     peakModeButton.getToggleStateValue().referTo(editor.peakModeValue);
 }
 
-void SettingsComponent::makeResizedSection(CheapLabel& l, juce::Button& b1, juce::Button& b2, juce::Rectangle<int> r) {
+void SettingsComponent::setAnalyserMode(int mode) {
+    const juce::Colour colours[ANALYSER_MODE_AMT] = { juce::Colours::yellow, juce::Colours::limegreen, juce::Colours::orange, juce::Colours::white };
+    mode = juce::jlimit(0, ANALYSER_MODE_AMT - 1, mode);
+    analyserModeButton.setButtonText(analyserModes[mode]);
+    analyserModeButton.setColour(juce::TextButton::buttonColourId, colours[mode]);
+}
+
+void SettingsComponent::setAnalyserChannel(int channel) {
+    channel = juce::jlimit(0, ANALYSER_CHANNEL_AMT - 1, channel);
+    analyserChannelButton.setButtonText(analyserChannels[channel]);
+    analyserChannelButton.setColour(juce::TextButton::buttonColourId, channel == ANALYSER_LR ? juce::Colours::cyan : juce::Colours::lightgrey);
+}
+
+void SettingsComponent::setAnalyserAverage(int average) {
+    const juce::Colour colours[ANALYSER_AVG_AMT] = { juce::Colours::darkgrey, juce::Colours::orange, juce::Colours::lightblue, juce::Colours::cyan };
+    average = juce::jlimit(0, ANALYSER_AVG_AMT - 1, average);
+    analyserAverageButton.setButtonText(analyserAverages[average]);
+    analyserAverageButton.setColour(juce::TextButton::buttonColourId, colours[average]);
+}
+
+void SettingsComponent::setAnalyserSmoothing(int smoothing) {
+    smoothing = juce::jlimit(0, ANALYSER_SMOOTH_AMT - 1, smoothing);
+    analyserSmoothingButton.setButtonText(analyserSmoothings[smoothing]);
+    analyserSmoothingButton.setColour(juce::TextButton::buttonColourId, smoothing == ANALYSER_SMOOTH_OFF ? juce::Colours::darkgrey : juce::Colours::lightgreen);
+}
+
+void SettingsComponent::setCurveTraces(int mode) {
+    mode = juce::jlimit(0, CURVE_TRACES_AMT - 1, mode);
+    curveTracesButton.setButtonText(curveTraces[mode]);
+    curveTracesButton.setColour(juce::TextButton::buttonColourId, mode == CURVE_TRACES_OFF ? juce::Colours::darkgrey : juce::Colours::plum);
+}
+
+void SettingsComponent::setUiScale(int mode) {
+    mode = juce::jlimit(0, UI_SCALE_AMT - 1, mode);
+    uiScaleButton.setButtonText(uiScales[mode]);
+    uiScaleButton.setColour(juce::TextButton::buttonColourId, mode == UI_SCALE_LARGE ? juce::Colours::darkgrey : juce::Colours::lightgrey);
+}
+
+void SettingsComponent::splitRow(std::initializer_list<juce::Button*> buttons) {
+    auto r = (*buttons.begin())->getBounds();
+    const int num = (int)buttons.size();
+    const int w = (r.getWidth() - (num - 1) * BUTTON_SPACING) / num;
+    //last one takes what rounding left over
+    for (auto* b : buttons) {
+        b->setBounds(b == *(buttons.end() - 1) ? r : r.removeFromLeft(w));
+        r.removeFromLeft(BUTTON_SPACING);
+    }
+}
+
+void SettingsComponent::makeSection(CheapLabel& l, juce::Rectangle<int> r, std::initializer_list<std::initializer_list<juce::Button*>> rows) {
     l.setBounds(r.removeFromTop(LABEL_HEIGHT));
-    auto r1 = r.removeFromTop(r.getHeight() / 2);
-    r1.reduce(BUTTON_SPACING, BUTTON_SPACING);
-    r.reduce(BUTTON_SPACING, BUTTON_SPACING);
-    b1.setBounds(r1);
-    b2.setBounds(r);
+    const int h = r.getHeight() / (int)rows.size();
+    //last row takes what rounding left over
+    for (const auto& row : rows) {
+        auto rowBounds = &row == rows.end() - 1 ? r : r.removeFromTop(h);
+        rowBounds.reduce(BUTTON_SPACING, BUTTON_SPACING);
+        (*row.begin())->setBounds(rowBounds);
+        splitRow(row);
+    }
 }
 
 void SettingsComponent::mouseDrag(const juce::MouseEvent& event) {
@@ -124,6 +268,9 @@ void SettingsComponent::resetTopLeftProps() {
     else {
         audioProcessor.tree.state.setProperty(props[SETTINGS_Y], SETTINGS_TOPLEFT_Y, nullptr);
     }
+    //sessions saved with the smaller panel can hold a position that would now hang off the window, same limits as a drag
+    topLeft.x = juce::jlimit(0, MAIN_WINDOW_WIDTH - SETTINGS_SIZE_X, topLeft.x);
+    topLeft.y = juce::jlimit(0, MAIN_WINDOW_HEIGHT - SETTINGS_SIZE_Y, topLeft.y);
 }
 
 void SettingsComponent::setupCreditsWindow(CustomLookAndFeelE& lnfe) {
@@ -11,7 +11,7 @@ class CustomLookAndFeelD;
 class CustomLookAndFeelE;
 
 //==============================================================================
-/** houses analyser and peak settings buttons, can minimize
+/** houses analyser, curve, and peak settings buttons, can minimize
 */
 struct SettingsComponent : public MinimizableComponent {
     SettingsComponent(SemiProQAudioProcessor&, SemiProQAudioProcessorEditor&, CustomLookAndFeelC&, CustomLookAndFeelD&, CustomLookAndFeelE&);
@@ -19,13 +19,25 @@ struct SettingsComponent : public MinimizableComponent {
 
     //helper to set buttons to editor values
     void referValuesToButtons(juce::Value& v) override;
+    //text and colour of the analyser mode and channel buttons, called by the editor when they change
+    void setAnalyserMode(int mode);
+    void setAnalyserChannel(int channel);
+    void setAnalyserAverage(int average);
+    void setAnalyserSmoothing(int smoothing);
+    void setCurveTraces(int mode);
+    void setUiScale(int mode);
 
 private:
     void paint(juce::Graphics& g) override;
+    //everything paint shows, rendered into the chrome layer
+    void paintChrome(juce::Graphics& g);
     void resized() override;
     //helpers to clean up constructor and resized
     //void makeLabel(juce::Label& label, juce::String text);
-    void makeResizedSection(CheapLabel& l, juce::Button& b1, juce::Button& b2, juce::Rectangle<int> r);
+    //label on top of r, then rows of equal height, each row's buttons side by side
+    void makeSection(CheapLabel& l, juce::Rectangle<int> r, std::initializer_list<std::initializer_list<juce::Button*>> rows);
+    //splits the first button's bounds evenly between all of them, side by side
+    void splitRow(std::initializer_list<juce::Button*> buttons);
     void mouseDrag(const juce::MouseEvent& event) override;
     void resetTopLeftProps();
     void setupCreditsWindow(CustomLookAndFeelE& lnfe);
@@ -36,6 +48,8 @@ private:
 
     //need slope switch button for analyser
     juce::ToggleButton analyserOnButton, peakOnButton;
-    juce::TextButton analyserModeButton, peakModeButton, helpButton, creditsButton;
-    CheapLabel analyserSettingsLabel, peakSettingsLabel, blankLabel, componentLabel;
+    juce::TextButton analyserModeButton, analyserChannelButton, analyserAverageButton, analyserSmoothingButton, curveTracesButton, spectrogramButton, fillButton, peakModeButton, uiScaleButton, helpButton, creditsButton;
+    CheapLabel analyserSettingsLabel, curveSettingsLabel, peakSettingsLabel, blankLabel, componentLabel;
+    //peak section, its top edge divides it from the curve section above
+    juce::Rectangle<int> peakArea;
 };
@@ -38,16 +38,29 @@ struct HelpWindow : juce::Component {
             "\n"
             "- Left click on any visible filter to select it and show all of its parameters in the Selected Filter component\n"
             "\n"
-            "- The Selected Filter component allows for 8 filter types, q or dB/oct adjustment, bypassing and deleting when a filter is selected\n"
+            "- The Selected Filter component allows for 9 filter types, q or dB/oct adjustment, bypassing and deleting when a filter is selected. X-OVER sends bands to the aux outputs\n"
             "\n"
             "- The selected filter's color will be shown in the top left of the Selected Filter component and the filter's circle will have a white outline\n"
             "\n"
+            "- Each active filter's own response is shaded in its circle's color under the white combined curve\n"
+            "\n"
+            "- The MAG button under CURVE in Settings cycles extra traces over the curve: PHASE (purple, +-180 degrees over the full height), DELAY (pink group delay, 0 to 20 ms bottom to top), or PH+GD for both\n"
+            "\n"
             "- Spectrum analyser and peak meter(s) initialize as on and post-eq. The buttons to change these Settings are in the Settings component\n"
             "\n"
             "- All of these settings, component positions, minimized states, and filter parameters are saved and loaded on window open per instance\n"
             "\n"
             "- If any channel clips, the meter will show a notification as a red rectangle. Clicking the meter will remove the notification\n"
             "\n"
+            "- The analyser mode button cycles PRE, POST, BOTH (yellow pre under green post), and DELTA (both plus a white post minus pre trace on the filter dB scale, so it lines up with the response curve)\n"
+            "\n"
+            "- The analyser channel button next to it cycles MID (L + R), SIDE (L - R), L, R, and L+R, which overlays left (cyan) and right (magenta) of the pre tap in PRE mode and the post tap otherwise\n"
+            "\n"
+            "- SPEC turns on a scrolling spectrogram of the main analyser trace behind the curve, newest at the top. Quiet levels are see-through so the grid stays readable\n"
+            "\n"
+            "- The hold button cycles LIVE, MAX (max-hold), AVG (~3 s average), and INT (average of everything since it was selected, for comparing a whole song). It draws a thin trace over post, or over pre / left when post isn't shown. Cycling back to a mode starts it over. FILL adds a gradient under the live traces\n"
+            "- The smoothing button cycles RAW, 1/24, 1/12, 1/6, 1/3, and 1/1 octave. Each point becomes the average power over that fraction of an octave around it, for reading tonal balance instead of single peaks\n"
+            "\n"
             "- The spectrum analyser has a 4.5 dB/oct tilt applied to it to allow for better visualization of the high end\n"
             "\n"
             "- The spectrum analyser is meant to line up with the dB of the peak filter + 12dB roughly. It does not correlate to the filter decibels\n"
@@ -57,6 +70,8 @@ struct HelpWindow : juce::Component {
             "- The Gain, Settings, and Selected Filter components are all minimizable by using the button in the top right of the component\n"
             "\n"
             "- The same components are also all movable by clicking and dragging anywhere on the component that isn't housing a slider\n"
+            "\n"
+            "- The L button next to HELP cycles the plugin window between large, medium (85%), and small (70%) sizes\n"
         );
 
         closeButton.setLookAndFeel(&lnf);
@@ -18,7 +18,7 @@ PeakMeterComponent::PeakMeterComponent(SemiProQAudioProcessor& p) : audioProcess
 
 PeakMeterComponent::~PeakMeterComponent() {}
 
-void PeakMeterComponent::timerCallback() {
+juce::Rectangle<int> PeakMeterComponent::frameCallback() {
     //destructive read
     float leftPeakValue = audioProcessor.leftPeak.read();
     //Replace peak
@@ -34,6 +34,7 @@ void PeakMeterComponent::timerCallback() {
     }
     //count down hold or linear drop after hold frames run out
     (leftPeakHoldCounter > 0.0f) ? leftPeakHoldCounter-- : leftPeakHold = leftPeakHold * 0.975f;
+    leftLevel = getSmoothedValue(currLeftPeak);
 
     //do the same for right
     if (channels > 1) {
@@ -47,14 +48,34 @@ void PeakMeterComponent::timerCallback() {
             rightClipNotifier = true;
         }
         (rightPeakHoldCounter > 0) ? rightPeakHoldCounter-- : rightPeakHold = rightPeakHold * 0.975f;
+        rightLevel = getSmoothedValue(currRightPeak);
     }
-    repaint();
+
+    //only meters that would draw differently, so a stopped transport settles to nothing
+    juce::Rectangle<int> dirty;
+    const auto left = getMeterState(leftLevel, leftPeakHold, leftClipNotifier, leftRect);
+    if (left != leftDrawn) {
+        leftDrawn = left;
+        dirty = getMeterColumn(leftRect);
+    }
+    if (channels > 1) {
+        const auto right = getMeterState(rightLevel, rightPeakHold, rightClipNotifier, rightRect);
+        if (right != rightDrawn) {
+            rightDrawn = right;
+            dirty = dirty.isEmpty() ? getMeterColumn(rightRect) : dirty.getUnion(getMeterColumn(rightRect));
+        }
+    }
+    return dirty;
 }
 
+//fills under the cached outlines, ticks, and labels, then the live hold and clip parts on top
 void PeakMeterComponent::paint(juce::Graphics& g) {
+    drawFilledMeter(g, leftLevel, leftRect);
+    if (channels > 1) {
+        drawFilledMeter(g, rightLevel, rightRect);
+    }
+    chrome.draw(g, *this, [this](juce::Graphics& cg) { paintChrome(cg); });
     //left meter draw functions
-    drawFilledMeter(g, getSmoothedValue(currLeftPeak), leftRect);
-    drawOutlineRect(g, leftRect);
     drawHoldLine(g, leftPeakHold, leftHoldRect, leftRect);
     if (leftClipNotifier) {
         drawClipNotifier(g, leftClipRect);
@@ -62,24 +83,26 @@ void PeakMeterComponent::paint(juce::Graphics& g) {
     drawHoldText(g, leftPeakHold, leftRect);
     //right meter draw functions
     if (channels > 1) {
-        drawFilledMeter(g, getSmoothedValue(currRightPeak), rightRect);
-        drawOutlineRect(g, rightRect);
         drawHoldLine(g, rightPeakHold, rightHoldRect, rightRect);
         if (rightClipNotifier) {
             drawClipNotifier(g, rightClipRect);
         }
         drawHoldText(g, rightPeakHold, rightRect);
     }
+}
+
+void PeakMeterComponent::paintChrome(juce::Graphics& g) {
+    drawOutlineRect(g, leftRect);
+    if (channels > 1) {
+        drawOutlineRect(g, rightRect);
+    }
     drawLabelText(g);
 }
 
 void PeakMeterComponent::drawFilledMeter(juce::Graphics& g, float peak, juce::Rectangle<int>& r) {
-    //map based on dB, clamp, set top to percent of the meter from map, fill with fillColor
-    float peak_dB = juce::Decibels::gainToDecibels(peak, MIN_ANALYSIS_DB);
-    float fill = juce::jmap(peak_dB, MIN_ANALYSIS_DB, 0.0f, 0.0f, 1.0f);
-    fill = juce::jlimit(0.0f, 1.0f, fill);
+    //set top to percent of the meter from map, fill with fillColor
     int h = r.getHeight();
-    int newH = static_cast<int>(h * fill);
+    int newH = gainToPixels(peak, h);
     g.setColour(fillColor);
     g.fillRect(r.getX(), r.getY() + h - newH, r.getWidth(), newH);
 }
@@ -115,12 +138,9 @@ void PeakMeterComponent::drawLabelText(juce::Graphics& g) {
 }
 
 void PeakMeterComponent::drawHoldLine(juce::Graphics& g, float hold, juce::Rectangle<int> line, juce::Rectangle<int>& r) {
-    //map based on dB, clamp, move peak line based on given float, then draw it
-    float hold_dB = juce::Decibels::gainToDecibels(hold, MIN_ANALYSIS_DB);
-    float lineY = juce::jmap(hold_dB, MIN_ANALYSIS_DB, 0.0f, 0.0f, 1.0f);
-    lineY = juce::jlimit(0.0f, 1.0f, lineY);
+    //move peak line based on given float, then draw it
     int h = r.getHeight();
-    line.setY(r.getY() + h - static_cast<int>(h * lineY));
+    line.setY(r.getY() + h - gainToPixels(hold, h));
     g.setColour(juce::Colours::white);
     g.fillRect(line);
 }
@@ -160,6 +180,7 @@ void PeakMeterComponent::resized() {
         auto trimTo = (bounds.getWidth() - METER_WIDTH) / 2;
         resizeMeter(leftRect, leftClipRect, leftHoldRect, bounds.withTrimmedLeft(trimTo).withTrimmedRight(trimTo)); 
     } 
+    chrome.invalidate();
 }
 
 void PeakMeterComponent::mouseDown(const juce::MouseEvent& event) {
@@ -183,6 +204,27 @@ float PeakMeterComponent::getSmoothedValue(juce::SmoothedValue<float>& value) {
     }
 }
 
+int PeakMeterComponent::gainToPixels(float gain, int h) const {
+    //map based on dB, clamp, then scale to the meter
+    float dB = juce::Decibels::gainToDecibels(gain, MIN_ANALYSIS_DB);
+    float amt = juce::jlimit(0.0f, 1.0f, juce::jmap(dB, MIN_ANALYSIS_DB, 0.0f, 0.0f, 1.0f));
+    return static_cast<int>(h * amt);
+}
+
+PeakMeterComponent::MeterState PeakMeterComponent::getMeterState(float level, float hold, bool clip, const juce::Rectangle<int>& r) const {
+    MeterState state;
+    state.fill = gainToPixels(level, r.getHeight());
+    state.hold = gainToPixels(hold, r.getHeight());
+    state.holdTenths = juce::roundToInt(juce::Decibels::gainToDecibels(hold, MIN_ANALYSIS_DB) * 10.0f);
+    state.clip = clip;
+    return state;
+}
+
+juce::Rectangle<int> PeakMeterComponent::getMeterColumn(const juce::Rectangle<int>& r) const {
+    //hold readout is centred 14 above the meter and a bit wider than it, the outline sits 1 outside
+    return { r.getX() - 4, r.getY() - 21, r.getWidth() + 8, r.getHeight() + 22 };
+}
+
 void PeakMeterComponent::resetValues() {
     leftPeakHold = 0.0f;
     rightPeakHold = 0.0f;
@@ -190,6 +232,8 @@ void PeakMeterComponent::resetValues() {
     currRightPeak.setCurrentAndTargetValue(0.0f);
     leftPeakHoldCounter = 0;
     rightPeakHoldCounter = 0;
+    leftLevel = 0.0f;
+    rightLevel = 0.0f;
 }
 
 //setup rects for meter, hold, and clip
@@ -204,6 +248,7 @@ void PeakMeterComponent::setYs(juce::Array<float>& newYs) {
     ys = newYs;
     int n = ys.size() - 1;
     ys.set(n, ys[n] - 4);
+    chrome.invalidate();
 }
 
 
@@ -3,6 +3,7 @@
 
 #include <JuceHeader.h>
 #include "Utils/Constants.h"
+#include "Utils/ChromeLayer.h"
 
 class SemiProQAudioProcessor;
 
@@ -14,7 +15,8 @@ struct PeakMeterComponent : juce::Component {
     PeakMeterComponent(SemiProQAudioProcessor&);
     ~PeakMeterComponent();
 
-    void timerCallback();
+    //reads the peaks and steps the meters, returns the columns of the meters whose drawn state changed. Nothing once they're at rest
+    juce::Rectangle<int> frameCallback();
     void resetValues();
     void resized() override;
     void setYs(juce::Array<float>& newYs);
@@ -24,7 +26,16 @@ struct PeakMeterComponent : juce::Component {
     juce::Array<float> ys;
 
 private:
+    //everything a meter shows that can change, in pixels or tenths of a dB, compared between frames to skip repaints
+    struct MeterState {
+        int fill = -1, hold = -1, holdTenths = 0;
+        bool clip = false;
+        bool operator!=(const MeterState& o) const { return fill != o.fill || hold != o.hold || holdTenths != o.holdTenths || clip != o.clip; }
+    };
+
     void paint(juce::Graphics& g) override;
+    //outlines, 12 dB ticks, and dB labels, rendered into the chrome layer
+    void paintChrome(juce::Graphics& g);
     void drawFilledMeter(juce::Graphics& g, float peak, juce::Rectangle<int>& r);
     void drawOutlineRect(juce::Graphics& g, juce::Rectangle<int> r);
     void drawLabelText(juce::Graphics& g);
@@ -33,6 +44,11 @@ private:
     void drawHoldText(juce::Graphics& g, float hold, juce::Rectangle<int>& r);
     void mouseDown(const juce::MouseEvent& event) override;
     float getSmoothedValue(juce::SmoothedValue<float>& value);
+    //0 to h pixels of a gain on the meter's MIN_ANALYSIS_DB to 0 scale
+    int gainToPixels(float gain, int h) const;
+    MeterState getMeterState(float level, float hold, bool clip, const juce::Rectangle<int>& r) const;
+    //meter, outline, clip light, and hold readout above it
+    juce::Rectangle<int> getMeterColumn(const juce::Rectangle<int>& r) const;
     void resizeMeter(juce::Rectangle<int>& m, juce::Rectangle<int>& h, juce::Rectangle<int>& c, juce::Rectangle<int> bounds);
     SemiProQAudioProcessor& audioProcessor;
 
@@ -40,9 +56,13 @@ private:
     juce::Rectangle<int> leftRect, rightRect;
     float leftPeakHold = 0.0f, rightPeakHold = 0.0f;
     int leftPeakHoldCounter = 0, rightPeakHoldCounter = 0;
+    //smoothed levels stepped once per frame, paint only reads them
+    float leftLevel = 0.0f, rightLevel = 0.0f;
+    MeterState leftDrawn, rightDrawn;
     juce::Rectangle<int> leftHoldRect, rightHoldRect, leftClipRect, rightClipRect;
     bool leftClipNotifier = false, rightClipNotifier = false;
     const juce::StringArray dBs{ "-96", "-84", "-72", "-60", "-48", "-36", "-24", "-12", "0" };
+    ChromeLayer chrome;
 };
 
 ////mono version
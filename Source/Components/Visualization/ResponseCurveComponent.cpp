@@ -3,188 +3,570 @@
 #include "PluginProcessor.h"
 
 //==============================================================================
-/** Response Curve: on parameter change only now, but can further be optimised by checking bandwidth of changed eq and clipping the paint,
+/** Response Curve: on parameter change only, and only over the columns the changed bands actually move. Paint skips the samples
+    outside the clip, so a drag strokes the changed stretch instead of the whole curve
 */
 ResponseCurveComponent::ResponseCurveComponent(SemiProQAudioProcessor& p) : audioProcessor(p) {
     setInterceptsMouseClicks(false, false);
     setOpaque(false);
-    blockSize = getLocalBounds().getWidth();
-    freqs.allocate(blockSize, false);
-    precomputePixelFreqs();
-    mags.allocate(blockSize, false);
 }
 
 ResponseCurveComponent::~ResponseCurveComponent() {}
 
 //only strokes cached path in area of passed clip
 void ResponseCurveComponent::paint(juce::Graphics& g) {
-    if (mags == nullptr) return;
-    int xPos = getLocalBounds().getX();
+    if (curveX.empty()) return;
+    //samples are resolution independent, so a resize only changes this mapping
+    auto responseArea = getLocalBounds().toFloat();
+    const float width = responseArea.getWidth() - 1.0f;
+    const float bottom = responseArea.getBottom();
+    const float top = responseArea.getY();
+    if (width <= 0.0f) return;
+    //a ui scale or display change doesn't resize, so the layer follows the scale it's actually drawn at
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (scale != layerScale) {
+        rebuildBandLayer(scale);
+    }
+    //band shapes go under the curve, brought up to date first if a band moved since the last paint
+    if (!layerDirty.isEmpty()) {
+        renderBandLayer(layerDirty);
+        layerDirty = {};
+    }
+    if (bandLayer.isValid()) {
+        g.drawImageTransformed(bandLayer, juce::AffineTransform::scale(1.0f / layerScale));
+    }
+    auto map = [bottom, top](float input) { return juce::jmap(input, MIN_DB, MAX_DB, bottom, top); };
+    //first and last sample that can reach the clip, plus one either side so the segments crossing its edges are kept
+    const auto clip = g.getClipBounds().toFloat().expanded(CURVE_STROKE, 0.0f);
+    const double clipLo = (clip.getX() - responseArea.getX()) / width;
+    const double clipHi = (clip.getRight() - responseArea.getX()) / width;
+    const size_t last = curveX.size() - 1;
+    size_t start = (size_t)(std::lower_bound(curveX.begin(), curveX.end(), clipLo) - curveX.begin());
+    size_t end = (size_t)(std::upper_bound(curveX.begin(), curveX.end(), clipHi) - curveX.begin());
+    start = start > 0 ? start - 1 : 0;
+    end = juce::jmin(end, last);
+    if (end <= start) return;
     juce::Path path;
-    path.startNewSubPath(xPos, mags[0]);
-    for (int i = 1; i < blockSize; ++i) {
-        path.lineTo(++xPos, mags[i]);
+    path.preallocateSpace((int)(end - start + 1) * 3);
+    //phase is wrapped for display, so the trace breaks wherever it jumps a whole turn instead of drawing the jump
+    if (traces == CURVE_TRACES_PHASE || traces == CURVE_TRACES_BOTH) {
+        const float pi = juce::MathConstants<float>::pi;
+        auto mapPhase = [bottom, top, pi](float input) { return juce::jmap(input, -pi, pi, bottom, top); };
+        float prev = 0.0f;
+        for (size_t i = start; i <= end; ++i) {
+            const float wrapped = std::remainder(curvePhase[i], 2.0f * pi);
+            const float px = responseArea.getX() + (float)curveX[i] * width;
+            if (i == start || std::abs(wrapped - prev) > pi) {
+                path.startNewSubPath(px, mapPhase(wrapped));
+            }
+            else {
+                path.lineTo(px, mapPhase(wrapped));
+            }
+            prev = wrapped;
+        }
+        g.setColour(juce::Colours::mediumpurple);
+        g.strokePath(path, juce::PathStrokeType(CURVE_STROKE * 0.5f));
+        path.clear();
+    }
+    if (traces == CURVE_TRACES_DELAY || traces == CURVE_TRACES_BOTH) {
+        auto mapDelay = [bottom, top](float input) { return juce::jmap(input, 0.0f, CURVE_DELAY_RANGE_MS, bottom, top); };
+        path.startNewSubPath(responseArea.getX() + (float)curveX[start] * width, mapDelay(curveDelay[start]));
+        for (size_t i = start + 1; i <= end; ++i) {
+            path.lineTo(responseArea.getX() + (float)curveX[i] * width, mapDelay(curveDelay[i]));
+        }
+        g.setColour(juce::Colours::hotpink);
+        g.strokePath(path, juce::PathStrokeType(CURVE_STROKE * 0.5f));
+        path.clear();
+    }
+    path.startNewSubPath(responseArea.getX() + (float)curveX[start] * width, map(curveDb[start]));
+    for (size_t i = start + 1; i <= end; ++i) {
+        path.lineTo(responseArea.getX() + (float)curveX[i] * width, map(curveDb[i]));
     }
     g.setColour(juce::Colours::white);
-    g.strokePath(path, juce::PathStrokeType(3.0f));
+    g.strokePath(path, juce::PathStrokeType(CURVE_STROKE));
 }
 
-void ResponseCurveComponent::timerCallback() {
-    //get width and ensure arrays are the correct size, then compute freqs if size changed
-    auto w = getLocalBounds().getWidth();
-    if (w <= 0) {
-        return;
-    }
-    if (blockSize != w) {
-        blockSize = w;
-        mags.realloc(blockSize);
-        freqs.realloc(blockSize);
-        precomputePixelFreqs();
-    }
-    //reset all mag array values to 1.0
-    resetMags();
+juce::Rectangle<int> ResponseCurveComponent::frameCallback() {
+    //resample whichever bands changed, a drag is one band per frame
+    const bool changed = updateBands();
 
-    //use helper to update mag array using filters
-    updateMagsFromFilters();
+    //add up the cached bands on the union of their samples, only when one of them moved or toggled. most frames nothing did
+    const bool firstCurve = curveX.empty();
+    if (changed || firstCurve) {
+        composeCurve();
+    }
 
-    //sets each mag double to decibels
-    magsToDecibels();
+    //the component isn't opaque, so repainting this also repaints the analyser strip behind it
+    if (firstCurve) {
+        layerDirty = getLocalBounds();
+        return layerDirty;
+    }
+    if (hasDirty) {
+        const auto area = getDirtyArea();
+        layerDirty = layerDirty.isEmpty() ? area : layerDirty.getUnion(area);
+        return area;
+    }
+    return {};
+}
 
-    //map mags to pixels for path in paint
-    magsToYCoords();
+void ResponseCurveComponent::setBandColour(int i, juce::Colour c) {
+    bandColours[i] = c;
+}
 
+//magnitude only bands have no phase or delay in their samples, so turning a trace on resamples everything
+void ResponseCurveComponent::setTraces(int mode) {
+    mode = juce::jlimit(0, CURVE_TRACES_AMT - 1, mode);
+    if (mode == traces) return;
+    const bool resample = traces == CURVE_TRACES_OFF;
+    traces = mode;
+    if (resample) {
+        for (auto& band : bands) {
+            band.valid = false;
+        }
+        frameCallback();
+    }
     repaint();
 }
 
-//compute freq array based on size of component. Expects correct block size
-void ResponseCurveComponent::precomputePixelFreqs() {
-    for (int i = 0; i < blockSize; ++i) {
-        double frac = double(i) / double(blockSize - 1);
-        freqs[i] = freqRangeDbl.convertFrom0to1(frac);
-    }
+void ResponseCurveComponent::resized() {
+    rebuildBandLayer(juce::Component::getApproximateScaleFactorForComponent(this));
 }
 
-//reset all magnitudes to 1.0. Expects correct block size
-void ResponseCurveComponent::resetMags() {
-    for (int i = 0; i < blockSize; ++i) {
-        mags[i] = 1.0;
+//layer follows the size and the display's scale, so it's rebuilt whole here and nowhere else
+void ResponseCurveComponent::rebuildBandLayer(float scale) {
+    layerScale = scale;
+    const int w = juce::roundToInt((float)getWidth() * layerScale);
+    const int h = juce::roundToInt((float)getHeight() * layerScale);
+    if (w > 0 && h > 0) {
+        bandLayer = juce::Image(juce::Image::ARGB, w, h, true);
+        layerDirty = getLocalBounds();
     }
 }
 
-//updates every mag value based on filter values
-void ResponseCurveComponent::updateMagsFromFilters() {
-    //get sample rate, set to 44.1k if bad value (generally is around 0 if not the exact rate)
-    auto sampleRate = audioProcessor.getLastSampleRate();
-    //iterate through filters, if not bypassed or unititialized, copy safe coeff from req for use in modified getMagnitude to mult the entire arrays
+//only the bands' cached samples are read, nothing is evaluated here
+void ResponseCurveComponent::renderBandLayer(juce::Rectangle<int> area) {
+    if (!bandLayer.isValid()) return;
+    const float width = (float)getWidth() - 1.0f;
+    if (width <= 0.0f) return;
+    //clear and clip the same physical pixels so the edges of the patch line up with what's left around it
+    const auto physArea = (area.toFloat() * layerScale).getSmallestIntegerContainer().getIntersection(bandLayer.getBounds());
+    if (physArea.isEmpty()) return;
+    bandLayer.clear(physArea);
+    juce::Graphics g(bandLayer);
+    g.reduceClipRegion(physArea);
+    g.addTransform(juce::AffineTransform::scale(layerScale));
+    const float bottom = (float)getHeight();
+    auto map = [bottom](float input) { return juce::jmap(input, MIN_DB, MAX_DB, bottom, 0.0f); };
+    const float zeroY = map(0.0f);
+    //samples past the patch only matter for the segments crossing into it
+    const double lo = ((double)area.getX() - CURVE_STROKE) / width;
+    const double hi = ((double)area.getRight() + CURVE_STROKE) / width;
+    auto before = [](const CurveSample& s, double x) { return s.x < x; };
+    auto after = [](double x, const CurveSample& s) { return x < s.x; };
+    juce::Path shape;
     for (int i = 0; i < MAX_FILTERS; ++i) {
-        auto& info = audioProcessor.getFilterInfo(i);
-        if (info.bypass.load()) {
+        const auto& band = bands[i];
+        const auto& samples = band.samples;
+        if (!band.active || samples.size() < 2) {
             continue;
         }
-        if (info.type.load() == PEAK) {
-            getIdealPeakMags(sampleRate, info.gain.load(), info.freq.load(), info.quality.load());
-        }
-        else if (info.type.load() == NOTCH) {
-            getIdealNotchMags(sampleRate, info.freq.load(), info.quality.load());
+        size_t start = (size_t)(std::lower_bound(samples.begin(), samples.end(), lo, before) - samples.begin());
+        size_t end = (size_t)(std::upper_bound(samples.begin(), samples.end(), hi, after) - samples.begin());
+        start = start > 0 ? start - 1 : 0;
+        end = juce::jmin(end, samples.size() - 1);
+        if (end <= start) {
+            continue;
         }
-        else {
-            float* tmpCfs = tempCoeffs.data();
-            audioProcessor.getCoeffs(i, tmpCfs);
-            getMagnitudesFromFrequencyArray(sampleRate, tmpCfs, info.b_worth.load());
+        shape.clear();
+        shape.preallocateSpace((int)(end - start + 3) * 3);
+        shape.startNewSubPath((float)samples[start].x * width, zeroY);
+        for (size_t k = start; k <= end; ++k) {
+            shape.lineTo((float)samples[k].x * width, map(samples[k].db));
         }
+        shape.lineTo((float)samples[end].x * width, zeroY);
+        shape.closeSubPath();
+        g.setColour(bandColours[i].withAlpha(0.2f));
+        g.fillPath(shape);
     }
 }
 
-//modified juce internal function from coefficients class. Expects a precomputed freq array, prereset mag arry(all at 1.0), and set blockSize
-void ResponseCurveComponent::getMagnitudesFromFrequencyArray(double sampleRate, const float* coeffs, int stages) const noexcept {
-    constexpr std::complex<double> j(0, 1);
-    std::complex<double> numerator = 0.0, denominator = 1.0, factor = 1.0;
-
-    for (int i = 0; i < blockSize; ++i) {
-        numerator = 0.0, factor = 1.0, denominator = 1.0;
-        std::complex<double> jw = std::exp(-juce::MathConstants<double>::twoPi * freqs[i] * j / sampleRate);
-
-        for (int n = 0; n <= 2; ++n) {
-            numerator += static_cast<double>(coeffs[n]) * factor;
-            factor *= jw;
+//keys every band and resamples the ones that differ from their cache
+bool ResponseCurveComponent::updateBands() {
+    //get sample rate, set to 44.1k if bad value (generally is around 0 if not the exact rate)
+    auto sampleRate = audioProcessor.getLastSampleRate();
+    if (sampleRate <= 1.0) {
+        sampleRate = 44100.0;
+    }
+    //anything under half a pixel of movement isn't worth repainting
+    const float dbTol = CURVE_DIRTY_PX * (MAX_DB - MIN_DB) / (float)juce::jmax(1, getHeight());
+    hasDirty = false;
+    bool changed = false;
+    auto addDirty = [this](juce::Range<double> extent) {
+        if (extent.isEmpty()) return;
+        dirtyX = hasDirty ? dirtyX.getUnionWith(extent) : extent;
+        hasDirty = true;
+    };
+    std::array<float, BAND_KEY_SIZE> key;
+    for (int i = 0; i < MAX_FILTERS; ++i) {
+        auto& band = bands[i];
+        const bool wasActive = band.active && band.valid;
+        band.active = readBandKey(i, sampleRate, key);
+        if (band.active && (!band.valid || key != band.key)) {
+            //both the old and the new response have to be cleared off or drawn in
+            std::swap(band.samples, oldSamples);
+            if (wasActive) {
+                addDirty(getBandExtent(oldSamples, dbTol));
+            }
+            band.key = key;
+            sampleBand(band);
+            band.valid = true;
+            addDirty(getBandExtent(band.samples, dbTol));
+            changed = true;
         }
-
-        factor = jw;
-
-        for (int n = 3; n <= 4; ++n) {
-            denominator += static_cast<double> (coeffs[n]) * factor;
-            factor *= jw;
+        else if (band.active != wasActive && band.valid) {
+            //bypass toggled on an unchanged band
+            addDirty(getBandExtent(band.samples, dbTol));
+            changed = true;
         }
+    }
+    return changed;
+}
 
-        double mag = std::abs(numerator / denominator);
-        switch (stages) {
-        case 0: mags[i] *= mag; break;
-        case 1: mags[i] *= mag * mag; break;
-        case 2: mags[i] *= mag * mag * mag; break;
-        case 3: mags[i] *= mag * mag * mag * mag; break;
+//a shelf or pass filter runs out to an edge, a peak only covers its skirts
+juce::Range<double> ResponseCurveComponent::getBandExtent(const std::vector<CurveSample>& samples, float dbTol) const {
+    //phase and delay get the same half pixel on their own scales. phase counts wrapped, a pass filter's whole turns don't show
+    const float height = (float)juce::jmax(1, getHeight());
+    const bool phase = traces == CURVE_TRACES_PHASE || traces == CURVE_TRACES_BOTH;
+    const bool delay = traces == CURVE_TRACES_DELAY || traces == CURVE_TRACES_BOTH;
+    const float twoPi = juce::MathConstants<float>::twoPi;
+    const float phaseTol = CURVE_DIRTY_PX * twoPi / height;
+    const float delayTol = CURVE_DIRTY_PX * CURVE_DELAY_RANGE_MS / height;
+    int first = -1, last = -1;
+    for (int k = 0; k < (int)samples.size(); ++k) {
+        const auto& sample = samples[k];
+        if (std::abs(sample.db) > dbTol || (phase && std::abs(std::remainder(sample.phase, twoPi)) > phaseTol)
+            || (delay && std::abs(sample.delay) > delayTol)) {
+            if (first < 0) first = k;
+            last = k;
         }
     }
+    if (first < 0) {
+        return {};
+    }
+    const int lo = juce::jmax(0, first - 1);
+    const int hi = juce::jmin((int)samples.size() - 1, last + 1);
+    return { samples[lo].x, samples[hi].x };
 }
 
-//more ideal way to build the peak mags than using the digital coeffs. Fixes visual bugs and shows user intent more clearly. Is more expensive though
-void ResponseCurveComponent::getIdealPeakMags(double sampleRate, const double gain, const double f0, const double q) const noexcept {
-    double w0 = 2.0 * juce::MathConstants<double>::pi * f0;
-    double BW = w0 / q;
-    double A = std::sqrt(juce::Decibels::decibelsToGain(gain, (double)NEG_INF_DB));
-
-    for (int i = 0; i < blockSize; ++i) {
-        double f = freqs[i];
-        double w = 2.0 * juce::MathConstants<double>::pi * f;
-
-        double num_real = w0 * w0 - w * w;
-        double num_imag = w * BW * A;
-        double num_mag_sq = num_real * num_real + num_imag * num_imag;
-
-        double den_real = w0 * w0 - w * w;
-        double den_imag = w * BW / A;
-        double den_mag_sq = den_real * den_real + den_imag * den_imag;
+juce::Rectangle<int> ResponseCurveComponent::getDirtyArea() const {
+    const float width = (float)getWidth() - 1.0f;
+    //half the stroke plus a pixel for antialiasing
+    const float pad = CURVE_STROKE * 0.5f + 1.0f;
+    const int left = (int)std::floor((float)dirtyX.getStart() * width - pad);
+    const int right = (int)std::ceil((float)dirtyX.getEnd() * width + pad);
+    return juce::Rectangle<int>::leftTopRightBottom(left, 0, right, getHeight()).getIntersection(getLocalBounds());
+}
 
-        double mag = std::sqrt(num_mag_sq / den_mag_sq);
+//coefficient bands are keyed on the coefficients themselves, so a curve pass that lands before the audio thread has rebuilt them
+//is caught on a later pass instead of caching the old response under the new params. freq and q also seed the sampling
+bool ResponseCurveComponent::readBandKey(int i, double sampleRate, std::array<float, BAND_KEY_SIZE>& key) {
+    auto& info = audioProcessor.getFilterInfo(i);
+    const auto type = info.type.load();
+    //crossover splits don't touch the main output
+    if (info.bypass.load() || type == CROSSOVER) {
+        return false;
+    }
+    key.fill(0.0f);
+    key[0] = (float)type;
+    key[1] = (float)sampleRate;
+    key[3] = info.freq.load();
+    key[4] = info.gain.load();
+    key[5] = info.quality.load();
+    if (type != PEAK && type != NOTCH) {
+        //dB/oct filters have a different Q per stage, so each stage is read. Everything else is a single stage
+        const int stageAmt = isSlopeType(type) ? getCascadeStages(info.b_worth.load()) : 1;
+        key[2] = (float)stageAmt;
+        for (int j = 0; j < stageAmt; ++j) {
+            audioProcessor.getCoeffs(i, key.data() + 6 + j * COEFF_SIZE, j);
+        }
+    }
+    return true;
+}
 
-        mags[i] *= mag;
+//samples of one band from its key, sorted by x
+void ResponseCurveComponent::sampleBand(BandCache& band) {
+    const auto& key = band.key;
+    auto& samples = band.samples;
+    samples.clear();
+    const double sampleRate = key[1];
+    const bool digital = (int)key[0] != PEAK && (int)key[0] != NOTCH;
+    //coarse grid across the whole range, so flat stretches cost a couple dozen points. its x never move, so both kinds of tables are
+    //kept until the sample rate changes
+    if (gridX.empty() || gridRate != sampleRate) {
+        gridX.clear();
+        for (int k = 0; k <= CURVE_GRID_STEPS; ++k) {
+            gridX.push_back((double)k / (double)CURVE_GRID_STEPS);
+        }
+        fillTables(grid, gridX.data(), (int)gridX.size(), sampleRate, true, true);
+        gridRate = sampleRate;
+    }
+    evaluateBand(key, grid, (int)gridX.size());
+    appendBatch(samples, gridX);
+    //dense around the centre out to twice the bandwidth, which bisection alone could step over on a narrow peak or notch.
+    //Q's bandwidth in octaves, the dB/oct types just get an octave. kept while type, sample rate, freq and q hold, so gain moves
+    //evaluate the whole seed without any trig
+    const std::array<float, 4> centreKey{ key[0], key[1], key[3], key[5] };
+    if (centreKey != band.centreKey) {
+        band.centreKey = centreKey;
+        band.centreX.clear();
+        const double f0 = key[3];
+        const double q = key[5];
+        const bool slope = isSlopeType((int)key[0]);
+        const double bw = (slope || q <= 0.0) ? 1.0 : 2.0 / std::log(2.0) * std::asinh(1.0 / (2.0 * q));
+        for (double d : { 0.0, 0.125, 0.25, 0.5, 1.0, 2.0 }) {
+            for (double sign : { -1.0, 1.0 }) {
+                const double f = f0 * std::exp2(sign * d * bw);
+                if (f > MIN_FREQ && f < MAX_FREQ) {
+                    band.centreX.push_back(freqRangeDbl.convertTo0to1(f));
+                }
+            }
+        }
+        fillTables(band.centre, band.centreX.data(), (int)band.centreX.size(), sampleRate, digital, !digital);
+    }
+    evaluateBand(key, band.centre, (int)band.centreX.size());
+    appendBatch(samples, band.centreX);
+    std::sort(samples.begin(), samples.end(), [](const CurveSample& a, const CurveSample& b) { return a.x < b.x; });
+    samples.erase(std::unique(samples.begin(), samples.end(), [](const CurveSample& a, const CurveSample& b) { return b.x - a.x < CURVE_MIN_STEP * 0.5; }),
+                  samples.end());
+    intervals.clear();
+    for (size_t k = 1; k < samples.size(); ++k) {
+        intervals.push_back({ samples[k - 1], samples[k] });
+    }
+    //one batch per level: evaluate every open interval's midpoint, keep splitting the ones a straight line gets wrong
+    while (!intervals.empty() && (int)samples.size() < CURVE_MAX_SAMPLES) {
+        batchX.clear();
+        nextIntervals.clear();
+        for (const auto& in : intervals) {
+            if (in.hi.x - in.lo.x > CURVE_MIN_STEP) {
+                batchX.push_back(0.5 * (in.lo.x + in.hi.x));
+                nextIntervals.push_back(in);
+            }
+        }
+        std::swap(intervals, nextIntervals);
+        fillTables(scratch, batchX.data(), (int)batchX.size(), sampleRate, digital, !digital);
+        evaluateBand(key, scratch, (int)batchX.size());
+        nextIntervals.clear();
+        for (size_t k = 0; k < intervals.size(); ++k) {
+            const CurveSample mid{ batchX[k], batchDb[k], batchPhase[k], batchDelay[k] };
+            samples.push_back(mid);
+            const auto& in = intervals[k];
+            if (!isLinearEnough(in.lo, mid, in.hi)) {
+                nextIntervals.push_back({ in.lo, mid });
+                nextIntervals.push_back({ mid, in.hi });
+            }
+        }
+        std::swap(intervals, nextIntervals);
+    }
+    std::sort(samples.begin(), samples.end(), [](const CurveSample& a, const CurveSample& b) { return a.x < b.x; });
+    //each stage's atan2 is only known to a whole turn, sorted neighbours are close enough to take the nearest one
+    const float twoPi = juce::MathConstants<float>::twoPi;
+    for (size_t k = 1; k < samples.size(); ++k) {
+        samples[k].phase = samples[k - 1].phase + std::remainder(samples[k].phase - samples[k - 1].phase, twoPi);
     }
 }
 
-//more ideal way to build the peak mags than using the digital coeffs. Fixes visual bugs, shows user intent more clearly, and is a bit cheaper
-void ResponseCurveComponent::getIdealNotchMags(double sampleRate, const double f0, const double q) const noexcept {
-    double w0 = 2.0 * juce::MathConstants<double>::pi * f0;
+//phase is compared a turn at a time, lo to hi is taken the short way round before averaging
+bool ResponseCurveComponent::isLinearEnough(const CurveSample& lo, const CurveSample& mid, const CurveSample& hi) const {
+    if (std::abs(mid.db - 0.5f * (lo.db + hi.db)) > CURVE_SAMPLE_TOL_DB) {
+        return false;
+    }
+    if (traces == CURVE_TRACES_OFF) {
+        return true;
+    }
+    const float twoPi = juce::MathConstants<float>::twoPi;
+    const float midPhase = lo.phase + 0.5f * std::remainder(hi.phase - lo.phase, twoPi);
+    return std::abs(std::remainder(mid.phase - midPhase, twoPi)) <= CURVE_SAMPLE_TOL_PHASE
+        && std::abs(mid.delay - 0.5f * (lo.delay + hi.delay)) <= CURVE_SAMPLE_TOL_MS;
+}
 
-    for (size_t i = 0; i < blockSize; ++i) {
-        double w = 2.0 * juce::MathConstants<double>::pi * freqs[i];
+//2 pi f and its square for the ideal filters, sin^2(pi f / sr) and sin(2 pi f / sr) for the digital ones, at num points of x
+void ResponseCurveComponent::fillTables(PointTables& t, const double* x, int num, double sampleRate, bool digital, bool ideal) {
+    if ((int)t.phi.size() < num) {
+        t.omega.resize(num);
+        t.omegaSq.resize(num);
+        t.phi.resize(num);
+        t.sinW.resize(num);
+    }
+    for (int i = 0; i < num; ++i) {
+        const double f = freqRangeDbl.convertFrom0to1(x[i]);
+        if (digital) {
+            const double s = std::sin(juce::MathConstants<double>::pi * f / sampleRate);
+            t.phi[i] = s * s;
+            //sin(w) = 2 sin(w / 2) cos(w / 2), w stays under pi so the root is always positive
+            t.sinW[i] = 2.0 * std::sqrt(t.phi[i] * (1.0 - t.phi[i]));
+        }
+        if (ideal) {
+            t.omega[i] = juce::MathConstants<double>::twoPi * f;
+            t.omegaSq[i] = t.omega[i] * t.omega[i];
+        }
+    }
+}
 
-        double w_sq = w * w;
-        double w0_sq = w0 * w0;
-        double diff = w_sq - w0_sq;
-        double diff_sq = diff * diff;
+//last evaluated batch onto the end of samples
+void ResponseCurveComponent::appendBatch(std::vector<CurveSample>& samples, const std::vector<double>& x) const {
+    for (size_t k = 0; k < x.size(); ++k) {
+        samples.push_back({ x[k], batchDb[k], batchPhase[k], batchDelay[k] });
+    }
+}
 
-        double damping_term = (w * w0 / q);
-        double damping_sq = damping_term * damping_term;
+//updates the batch arrays with the band's response at every point of t in one pass per evaluator
+void ResponseCurveComponent::evaluateBand(const std::array<float, BAND_KEY_SIZE>& key, const PointTables& t, int num) {
+    if ((int)mags.size() < num) {
+        mags.resize(num);
+        phases.resize(num);
+        delays.resize(num);
+    }
+    batchDb.resize(num);
+    batchPhase.resize(num);
+    batchDelay.resize(num);
+    const int type = (int)key[0];
+    const bool digital = type != PEAK && type != NOTCH;
+    const double sampleRate = key[1];
+    const bool withPhase = traces != CURVE_TRACES_OFF;
+    //reset mags to 1.0, phase and delay to 0
+    std::fill(mags.begin(), mags.begin() + num, 1.0);
+    std::fill(phases.begin(), phases.begin() + num, 0.0);
+    std::fill(delays.begin(), delays.begin() + num, 0.0);
+    if (type == PEAK) {
+        getIdealPeakResponse(t, key[4], key[3], key[5], num, withPhase);
+    }
+    else if (type == NOTCH) {
+        getIdealNotchResponse(t, key[3], key[5], num, withPhase);
+    }
+    else {
+        //each stage multiplies in
+        const int stageAmt = (int)key[2];
+        for (int j = 0; j < stageAmt; ++j) {
+            multiplyStageResponse(key.data() + 6 + j * COEFF_SIZE, t.phi.data(), withPhase ? t.sinW.data() : nullptr, mags.data(), phases.data(),
+                                  delays.data(), num);
+        }
+    }
+    magsToDecibels(batchDb.data(), num);
+    //digital delay is in samples, the ideal filters' in seconds
+    const double delayScale = 1000.0 / (digital ? sampleRate : 1.0);
+    for (int i = 0; i < num; ++i) {
+        batchPhase[i] = (float)phases[i];
+        batchDelay[i] = (float)(delays[i] * delayScale);
+    }
+}
 
-        double mag = std::abs(diff) / std::sqrt(diff_sq + damping_sq);
+//product of the bands is the sum of their dB, each one's samples interpolated onto every other's positions. phase and delay add the same way
+void ResponseCurveComponent::composeCurve() {
+    curveX.clear();
+    for (const auto& band : bands) {
+        if (band.active) {
+            for (const auto& sample : band.samples) {
+                curveX.push_back(sample.x);
+            }
+        }
+    }
+    //nothing on, flat line
+    if (curveX.empty()) {
+        curveX = { 0.0, 1.0 };
+    }
+    std::sort(curveX.begin(), curveX.end());
+    curveX.erase(std::unique(curveX.begin(), curveX.end()), curveX.end());
+    curveDb.assign(curveX.size(), 0.0f);
+    curvePhase.assign(curveX.size(), 0.0f);
+    curveDelay.assign(curveX.size(), 0.0f);
+    const bool withPhase = traces != CURVE_TRACES_OFF;
+    for (const auto& band : bands) {
+        const auto& samples = band.samples;
+        if (!band.active || samples.size() < 2) {
+            continue;
+        }
+        //both sorted, so one walk per band
+        size_t j = 0;
+        for (size_t i = 0; i < curveX.size(); ++i) {
+            const double x = curveX[i];
+            while (j + 2 < samples.size() && samples[j + 1].x < x) {
+                ++j;
+            }
+            const auto& a = samples[j];
+            const auto& b = samples[j + 1];
+            const double span = b.x - a.x;
+            const float t = span > 0.0 ? (float)juce::jlimit(0.0, 1.0, (x - a.x) / span) : 0.0f;
+            curveDb[i] += a.db + t * (b.db - a.db);
+            if (withPhase) {
+                curvePhase[i] += a.phase + t * (b.phase - a.phase);
+                curveDelay[i] += a.delay + t * (b.delay - a.delay);
+            }
+        }
+    }
+    //same floor the product had
+    juce::FloatVectorOperations::max(curveDb.data(), curveDb.data(), NEG_INF_DB, (int)curveDb.size());
+}
 
-        mags[i] *= mag;
+//more ideal way to build the peak mags than using the digital coeffs. Fixes visual bugs and shows user intent more clearly
+//|H|^2 = ((w0^2 - w^2)^2 + w^2 BW^2 A^2) / ((w0^2 - w^2)^2 + w^2 BW^2 / A^2), straight off the w^2 table
+//each side's angle is atan2(w BW A, w0^2 - w^2), whose derivative gives a delay of BW A (w0^2 + w^2) / |.|^2, in seconds
+void ResponseCurveComponent::getIdealPeakResponse(const PointTables& t, const double gain, const double f0, const double q, int num, bool withPhase) noexcept {
+    const double w0 = juce::MathConstants<double>::twoPi * f0;
+    const double w0Sq = w0 * w0;
+    const double bwSq = w0Sq / (q * q);
+    const double aSq = juce::Decibels::decibelsToGain(gain, (double)NEG_INF_DB);
+    const double numScale = bwSq * aSq;
+    const double denScale = bwSq / aSq;
+    double* m = mags.data();
+    const double* wSq = t.omegaSq.data();
+    for (int i = 0; i < num; ++i) {
+        const double diff = w0Sq - wSq[i];
+        const double diffSq = diff * diff;
+        m[i] *= (diffSq + wSq[i] * numScale) / (diffSq + wSq[i] * denScale);
+    }
+    if (!withPhase) return;
+    const double numK = std::sqrt(numScale), denK = std::sqrt(denScale);
+    double* ph = phases.data();
+    double* gd = delays.data();
+    const double* w = t.omega.data();
+    for (int i = 0; i < num; ++i) {
+        const double diff = w0Sq - wSq[i];
+        const double diffSq = diff * diff;
+        const double sum = w0Sq + wSq[i];
+        ph[i] += std::atan2(w[i] * numK, diff) - std::atan2(w[i] * denK, diff);
+        gd[i] += denK * sum / (diffSq + wSq[i] * denScale) - numK * sum / (diffSq + wSq[i] * numScale);
     }
 }
 
-//gain to decibels on all mags in array. Expects correct block size
-void ResponseCurveComponent::magsToDecibels() {
-    for (int i = 0; i < blockSize; ++i) {
-        mags[i] = juce::Decibels::gainToDecibels(mags[i], (double)NEG_INF_DB);
+//more ideal way to build the peak mags than using the digital coeffs. Fixes visual bugs, shows user intent more clearly, and is a bit cheaper
+//|H|^2 = (w^2 - w0^2)^2 / ((w^2 - w0^2)^2 + w^2 w0^2 / q^2)
+//the numerator is real, so it only adds the half turn above w0 and no delay
+void ResponseCurveComponent::getIdealNotchResponse(const PointTables& t, const double f0, const double q, int num, bool withPhase) noexcept {
+    const double w0 = juce::MathConstants<double>::twoPi * f0;
+    const double w0Sq = w0 * w0;
+    const double damping = w0Sq / (q * q);
+    double* m = mags.data();
+    const double* wSq = t.omegaSq.data();
+    for (int i = 0; i < num; ++i) {
+        const double diff = wSq[i] - w0Sq;
+        const double diffSq = diff * diff;
+        m[i] *= diffSq / (diffSq + wSq[i] * damping);
+    }
+    if (!withPhase) return;
+    const double k = w0 / q;
+    double* ph = phases.data();
+    double* gd = delays.data();
+    const double* w = t.omega.data();
+    for (int i = 0; i < num; ++i) {
+        const double diff = w0Sq - wSq[i];
+        ph[i] += std::atan2(0.0, diff) - std::atan2(w[i] * k, diff);
+        gd[i] += k * (w0Sq + wSq[i]) / (diff * diff + wSq[i] * damping);
     }
 }
 
-void ResponseCurveComponent::magsToYCoords() {
-    //get area, make lambda map with values to map decibel mags,
-    auto responseArea = getLocalBounds();
-    const double outputMin = responseArea.getBottom();
-    const double outputMax = responseArea.getY();
-    auto map = [outputMin, outputMax](double input) { return juce::jmap(input, (double)MIN_DB, (double)MAX_DB, outputMin, outputMax); };
-    for (int i = 0; i < blockSize; ++i) {
-        mags[i] = map(mags[i]);
+//squared mags to decibels, 10 log10 instead of 20 so no root. Rounding can leave a notch's centre a hair under 0
+void ResponseCurveComponent::magsToDecibels(float* dest, int num) {
+    for (int i = 0; i < num; ++i) {
+        dest[i] = (float)juce::jmax((double)NEG_INF_DB, 10.0 * std::log10(juce::jmax(mags[i], 1.0e-30)));
     }
 }
@@ -4,45 +4,121 @@
 #include <JuceHeader.h>
 #include "Utils/AudioProcessing.h"
 #include "Utils/Constants.h"
+#include "Utils/VisualizerProcesing.h"
 
 class SemiProQAudioProcessor;
 
 //==============================================================================
-/** Response curve logic and painting
+/** Response curve logic and painting. Bands are sampled adaptively on the log freq range instead of once per pixel, so evaluation cost
+    follows how much the curve bends, not the editor width or scale. Each band's own shape is shaded underneath from the same samples
 */
 struct ResponseCurveComponent : juce::Component {
     ResponseCurveComponent(SemiProQAudioProcessor&);
     ~ResponseCurveComponent();
 
-    //draws path for curve then triggers repaint
-    void timerCallback();
+    //resamples changed bands and recomposes the curve, returns only the columns those bands moved
+    juce::Rectangle<int> frameCallback();
+    //fill colour of band i's own response, matched to its band node
+    void setBandColour(int i, juce::Colour c);
+    //phase and/or group delay traces over the curve, indexed by CURVE_TRACES_OFF..CURVE_TRACES_BOTH
+    void setTraces(int mode);
 
 private:
+    //type, sample rate, stage count, freq, gain, and q, then every stage's coefficients for the digital types
+    static constexpr int BAND_KEY_SIZE = 6 + MAX_STAGES * COEFF_SIZE;
+    //one point of a band's response, x on the 0 to 1 log freq range. phase in radians, unwrapped along the band once it's sorted,
+    //and group delay in ms. both stay 0 while no extra trace is on
+    struct CurveSample {
+        double x = 0.0;
+        float db = 0.0f;
+        float phase = 0.0f;
+        float delay = 0.0f;
+    };
+    //what the evaluators read at each point: 2 pi f and its square for the ideal filters, and sin^2(pi f / sr) and sin(2 pi f / sr) for
+    //the digital ones. only grows
+    struct PointTables {
+        std::vector<double> omega, omegaSq, phi, sinW;
+    };
+    //one band's samples and what they were computed from, so unchanged bands are never evaluated again
+    struct BandCache {
+        std::vector<CurveSample> samples;
+        std::array<float, BAND_KEY_SIZE> key{};
+        //seed points around the centre and their tables, with the type, sample rate, freq and q they were placed for
+        std::vector<double> centreX;
+        PointTables centre;
+        std::array<float, 4> centreKey{};
+        bool active = false;
+        bool valid = false;
+    };
+    //gap between two samples that still has to be checked
+    struct Interval {
+        CurveSample lo, hi;
+    };
+
     void paint(juce::Graphics& g) override;
-    //precomputed freq pixel positions based on logRange
-    void precomputePixelFreqs();
-    //sets magnitude array to 1.0
-    void resetMags();
+    void resized() override;
+    //reallocates the band layer at this scale and marks all of it for rendering
+    void rebuildBandLayer(float scale);
+    //clears area of the band layer and fills every active band's shape back into it
+    void renderBandLayer(juce::Rectangle<int> area);
     //make coefficients for mags update from targetValues to be more responsive
     void makeGUICoefficients(FilterInfo& info, double sr);
-    //update mags array for each filter
-    void updateMagsFromFilters();
-    //alternated interal juce coefficients function, requires coeffs pointer and expects allocated HeapBlocks
-    void getMagnitudesFromFrequencyArray(double sampleRate, const float* coeffs, int stages) const noexcept;
+    //resample only the bands whose key changed, widening dirtyX by wherever they or their old response bent the curve. true if any band
+    //was resampled or toggled, even under the dirty tolerance
+    bool updateBands();
+    //x range where the samples are further from 0 dB than dbTol, out to the next sample either side since those segments move too
+    juce::Range<double> getBandExtent(const std::vector<CurveSample>& samples, float dbTol) const;
+    //dirtyX in pixels, padded for the stroke and clamped to the bounds
+    juce::Rectangle<int> getDirtyArea() const;
+    //fills key for band i, false if the band doesn't touch the main output
+    bool readBandKey(int i, double sampleRate, std::array<float, BAND_KEY_SIZE>& key);
+    //coarse grid and points around the band's centre, then bisect wherever a straight line misses the midpoint by more than the tolerance
+    void sampleBand(BandCache& band);
+    //true if a straight line from lo to hi is close enough to mid in every quantity being drawn
+    bool isLinearEnough(const CurveSample& lo, const CurveSample& mid, const CurveSample& hi) const;
+    //tables at num points of x, the digital ones and/or the ideal filters' ones
+    void fillTables(PointTables& t, const double* x, int num, double sampleRate, bool digital, bool ideal);
+    //one sample per x out of the batch arrays just evaluated at those points
+    void appendBatch(std::vector<CurveSample>& samples, const std::vector<double>& x) const;
+    //dB, and phase and delay if a trace needs them, of the band in key at the first num points of t into batchDb, batchPhase and
+    //batchDelay. points are batched so each evaluator is one loop
+    void evaluateBand(const std::array<float, BAND_KEY_SIZE>& key, const PointTables& t, int num);
+    //union of every active band's sample positions, each band interpolated onto it and summed in dB
+    void composeCurve();
     //cheats to fix flickering on low end, high q sweeps by using the ideal analog equation rather than the digital coeffs
-    void getIdealPeakMags(double sampleRate, const double gain, const double f0, const double q) const noexcept;
+    void getIdealPeakResponse(const PointTables& t, const double gain, const double f0, const double q, int num, bool withPhase) noexcept;
     //cheats to fix flickering on low end, high q sweeps by using the ideal analog equation rather than the digital coeffs
-    void getIdealNotchMags(double sampleRate, const double q, const double f0) const noexcept;
-    //decibal conversion for each item in heapBlock
-    void magsToDecibels();
-    //maps dB mags to y pixel position
-    void magsToYCoords();
+    void getIdealNotchResponse(const PointTables& t, const double f0, const double q, int num, bool withPhase) noexcept;
+    //decibal conversion of the squared mags, into dest. the only place a root is taken, as the 1/2 in 10 log10
+    void magsToDecibels(float* dest, int num);
 
     SemiProQAudioProcessor& audioProcessor;
 
     juce::NormalisableRange<double> freqRangeDbl{ logRange<double>(MIN_FREQ, MAX_FREQ) };
-    juce::HeapBlock<double> mags, freqs;
-    //size of all allocated HeapBlocks, down sample is the divisor of blockSize. Basically, work/space recs is divided by downsampleMult
-    int blockSize;
-    std::array<float, COEFF_SIZE + 1> tempCoeffs;
+    //scratch for one batch of points: squared mags, phases and group delays, and the tables of the bisection midpoints. only grows, so a
+    //band's resample doesn't allocate once it's been through a few
+    std::vector<double> mags, phases, delays;
+    PointTables scratch;
+    //the fixed seed grid and both kinds of tables for it, rebuilt only when the sample rate changes
+    std::vector<double> gridX;
+    PointTables grid;
+    double gridRate = 0.0;
+    std::vector<double> batchX;
+    std::vector<float> batchDb, batchPhase, batchDelay;
+    std::vector<Interval> intervals, nextIntervals;
+    //every active band's sample positions and the summed dB there, drawn as a polyline scaled to the current bounds
+    std::vector<double> curveX;
+    std::vector<float> curveDb, curvePhase, curveDelay;
+    int traces = CURVE_TRACES_OFF;
+    BandCache bands[MAX_FILTERS];
+    //a changed band's previous samples, kept until its old extent is known
+    std::vector<CurveSample> oldSamples;
+    //x range the last update changed, empty when nothing moved
+    juce::Range<double> dirtyX;
+    bool hasDirty = false;
+    //each band's response filled to 0 dB, kept at physical resolution and only re-rendered where a band changed
+    juce::Image bandLayer;
+    float layerScale = 1.0f;
+    juce::Rectangle<int> layerDirty;
+    juce::Colour bandColours[MAX_FILTERS];
 };
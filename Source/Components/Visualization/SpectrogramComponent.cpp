@@ -0,0 +1,91 @@
+
+#include "SpectrogramComponent.h"
+
+//==============================================================================
+/** Spectrogram Component
+*/
+SpectrogramComponent::SpectrogramComponent() {
+    setInterceptsMouseClicks(false, false);
+    setOpaque(false);
+    //quiet is see-through so the grid stays readable, loud runs up to white
+    juce::ColourGradient gradient(juce::Colours::transparentBlack, 0.0f, 0.0f, juce::Colours::white, 1.0f, 0.0f, false);
+    gradient.addColour(0.35, juce::Colour(0x80000080));
+    gradient.addColour(0.55, juce::Colour(0xc0800080));
+    gradient.addColour(0.75, juce::Colour(0xffff4000));
+    gradient.addColour(0.9, juce::Colours::yellow);
+    for (int i = 0; i < SPECTROGRAM_PALETTE_SIZE; ++i) {
+        palette[i] = gradient.getColourAtPosition((double)i / (double)(SPECTROGRAM_PALETTE_SIZE - 1)).getPixelARGB();
+    }
+}
+
+void SpectrogramComponent::pushFrame(const float* frameDb, int num) {
+    if (!history.isValid() || num < 2) {
+        return;
+    }
+    if (num != lastFrameSize) {
+        updateColumnMapping(num);
+    }
+    //new frame goes one row above the last, the ring wraps at the top
+    writeRow = (writeRow == 0 ? history.getHeight() : writeRow) - 1;
+    rowsWritten = juce::jmin(rowsWritten + 1, history.getHeight());
+    const float scale = (float)(SPECTROGRAM_PALETTE_SIZE - 1) / -MIN_ANALYSIS_DB;
+    juce::Image::BitmapData row(history, 0, writeRow, history.getWidth(), 1, juce::Image::BitmapData::writeOnly);
+    for (int x = 0; x < row.width; ++x) {
+        const float level = (frameDb[columnIndex[x]] - MIN_ANALYSIS_DB) * scale;
+        const int idx = juce::jlimit(0, SPECTROGRAM_PALETTE_SIZE - 1, (int)level);
+        *reinterpret_cast<juce::PixelARGB*>(row.getPixelPointer(x, 0)) = palette[idx];
+    }
+    hasNewRows = true;
+}
+
+juce::Rectangle<int> SpectrogramComponent::frameCallback() {
+    if (!hasNewRows) {
+        return {};
+    }
+    hasNewRows = false;
+    return getLocalBounds();
+}
+
+void SpectrogramComponent::clear() {
+    if (history.isValid()) {
+        history.clear(history.getBounds());
+    }
+    writeRow = 0;
+    rowsWritten = 0;
+    hasNewRows = false;
+    repaint();
+}
+
+void SpectrogramComponent::paint(juce::Graphics& g) {
+    if (rowsWritten == 0) {
+        return;
+    }
+    //newest row at the top: the ring from writeRow down, then whatever wrapped from its top. both are 1:1 blits
+    const int w = history.getWidth();
+    const int h = history.getHeight();
+    const int upper = h - writeRow;
+    g.drawImage(history, 0, 0, w, upper, 0, writeRow, w, upper);
+    if (writeRow > 0) {
+        g.drawImage(history, 0, upper, w, writeRow, 0, 0, w, writeRow);
+    }
+}
+
+void SpectrogramComponent::resized() {
+    //history is per pixel, a new size starts over
+    if (getWidth() > 0 && getHeight() > 0) {
+        history = juce::Image(juce::Image::ARGB, getWidth(), getHeight(), true);
+    }
+    lastFrameSize = 0;
+    writeRow = 0;
+    rowsWritten = 0;
+}
+
+void SpectrogramComponent::updateColumnMapping(int num) {
+    lastFrameSize = num;
+    //frame values span the width evenly, same as the analyser's downsampled x positions
+    const int w = history.getWidth();
+    columnIndex.resize(w);
+    for (int x = 0; x < w; ++x) {
+        columnIndex[x] = juce::jlimit(0, num - 1, juce::roundToInt((float)x * (float)(num - 1) / (float)juce::jmax(1, w - 1)));
+    }
+}
@@ -0,0 +1,45 @@
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Utils/Constants.h"
+
+//==============================================================================
+/** Scrolling spectrogram behind the analyser, fed the analyser's finished frames on the message thread. Frequency runs along x so it
+    lines up with the grid and filters, newest frame at the top. Each frame writes one row into a persistent image ring through a palette
+    built once, and painting blits the two halves of the ring, so history is never re-rendered
+*/
+struct SpectrogramComponent : juce::Component {
+    SpectrogramComponent();
+    ~SpectrogramComponent() override = default;
+
+    //one analyser frame of num dB values, spread across the width the same way the analyser draws it
+    void pushFrame(const float* frameDb, int num);
+    //the whole ring scrolls with every row, so the area is everything if a row went in since the last call
+    juce::Rectangle<int> frameCallback();
+    //drop the history
+    void clear();
+
+private:
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+    //which frame value each x reads, rebuilt when the width or frame size changes
+    void updateColumnMapping(int num);
+
+    //ARGB so quiet levels stay transparent over the grid
+    juce::Image history;
+    //row the next frame goes into, moves up one per frame and wraps
+    int writeRow = 0;
+    //frames written since the last clear, so an empty ring isn't drawn
+    int rowsWritten = 0;
+    //a row went in since the last frameCallback
+    bool hasNewRows = false;
+    //dB to premultiplied colour, MIN_ANALYSIS_DB to 0 over SPECTROGRAM_PALETTE_SIZE steps
+    juce::PixelARGB palette[SPECTROGRAM_PALETTE_SIZE];
+    //frame index per x
+    std::vector<int> columnIndex;
+    //frame size the mapping was built for
+    int lastFrameSize = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrogramComponent)
+};
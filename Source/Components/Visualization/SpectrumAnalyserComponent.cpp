@@ -2,70 +2,336 @@
 #include "SpectrumAnalyserComponent.h"
 #include "PluginProcessor.h"
 
+//per instance size, before and after the ring reads. frames are window-read straight out of the rings, so the fft work arrays are the only
+//big members and everything else fits in 16 kB. the layout before kept a sampleData copy of the stream (FFT_SIZE + FFT_HOP_SIZE floats,
+//40 kB) and has to land over the same budget, so it can't come back unnoticed
+namespace {
+constexpr size_t analyserSizeBudget = sizeof(float) * (FFT_SIZE * 2 + (ANALYSER_TAPS + 1) * FFT_BIN_AMT + ANALYSER_TAPS * FFT_HOP_SIZE)
+                                      + sizeof(juce::dsp::Complex<float>) * FFT_SIZE * 2 + sizeof(double) * FFT_BIN_AMT + 16 * 1024;
+struct AnalyserWithSampleData : SpectrumAnalyserComponent {
+    float sampleData[FFT_SIZE + FFT_HOP_SIZE];
+};
+}
+static_assert(sizeof(SpectrumAnalyserComponent) < analyserSizeBudget, "SpectrumAnalyserComponent outgrew its fft work arrays");
+static_assert(sizeof(AnalyserWithSampleData) >= analyserSizeBudget, "the sampleData layout has to fail the budget the ring reads meet");
+static_assert(sizeof(AnalyserWithSampleData) - sizeof(SpectrumAnalyserComponent) >= sizeof(float) * (FFT_SIZE + FFT_HOP_SIZE),
+              "ring reads save at least the old sampleData buffer");
+
 //==============================================================================
 /** Analyser Component: all of my comments were lost because visual studio is garbage :(
 */
+//which of the pre, post, and delta traces a mode draws, one bit per trace. L+R always draws its left and right traces.
+//the hold trace bit is added on top when an average is on
+static int tracesFor(int mode, int channel) {
+    if (channel == ANALYSER_LR) {
+        return 0b011;
+    }
+    switch (mode) {
+        case ANALYSER_PRE:
+            return 0b001;
+        case ANALYSER_POST:
+            return 0b010;
+        case ANALYSER_DUAL:
+            return 0b011;
+        default:
+            return 0b111;
+    }
+}
+
+//what the processor puts in the ring for a mode and channel, pre/post modes only change it for L+R
+static int ringLayout(int mode, int channel) {
+    if (channel == ANALYSER_LR) {
+        return mode == ANALYSER_PRE ? ANALYSER_CHANNEL_AMT : ANALYSER_CHANNEL_AMT + 1;
+    }
+    return channel;
+}
+
 SpectrumAnalyserComponent::SpectrumAnalyserComponent(SemiProQAudioProcessor& p) : audioProcessor(p),
-forwardFFT(FFT_ORDER), window(FFT_SIZE + 1, juce::dsp::WindowingFunction<float>::hann) {
+forwardFFT(FFT_ORDER) {
     setInterceptsMouseClicks(false, false);
     setOpaque(false);
-    lineColor = juce::Colours::lime;
-    std::fill(std::begin(sampleData), std::end(sampleData), 0.0f);
+    //every point twice so it windows both halves of a packed pair
+    std::vector<float> hann(FFT_SIZE + 1);
+    juce::dsp::WindowingFunction<float>::fillWindowingTables(hann.data(), FFT_SIZE + 1, juce::dsp::WindowingFunction<float>::hann);
+    for (int i = 0; i < FFT_SIZE; ++i) {
+        windowTable[2 * i] = windowTable[2 * i + 1] = hann[i];
+    }
     std::fill(std::begin(fftData), std::end(fftData), 0.0f);
     std::fill(std::begin(binScalars), std::end(binScalars), 0.0f);
-    lastSampleRate = audioProcessor.getLastSampleRate();
-    //if decent sr given, compute bin scalars(tilt and power scale)
-    if (lastSampleRate > 1) {
-        computeBinScalars();
+    highHold.setSize(FFT_BIN_AMT);
+    for (auto& tap : taps) {
+        std::fill(std::begin(tap.hop), std::end(tap.hop), 0.0f);
+    }
+    //if decent sr given, set decimation and compute bin scalars(tilt and power scale)
+    const double sr = audioProcessor.getLastSampleRate();
+    if (sr > 1) {
+        updateSampleRate(sr);
     }
+    worker->addClient(this);
+}
+
+SpectrumAnalyserComponent::~SpectrumAnalyserComponent() {
+    //blocks until any job in flight is done
+    worker->removeClient(this);
 }
 
-SpectrumAnalyserComponent::~SpectrumAnalyserComponent() {}
+void SpectrumAnalyserComponent::setMode(int mode) {
+    analyserMode.store(juce::jlimit(0, ANALYSER_MODE_AMT - 1, mode));
+}
+
+void SpectrumAnalyserComponent::setChannel(int channel) {
+    analyserChannel.store(juce::jlimit(0, ANALYSER_CHANNEL_AMT - 1, channel));
+}
 
-void SpectrumAnalyserComponent::timerCallback() {
+void SpectrumAnalyserComponent::setAverage(int average) {
+    analyserAverage.store(juce::jlimit(0, ANALYSER_AVG_AMT - 1, average));
+}
+
+void SpectrumAnalyserComponent::setSmoothing(int smoothing) {
+    analyserSmoothing.store(juce::jlimit(0, ANALYSER_SMOOTH_AMT - 1, smoothing));
+}
+
+void SpectrumAnalyserComponent::setFill(bool shouldFill) {
+    //worker redraws with it on its next pass
+    fill.store(shouldFill);
+}
+
+juce::Rectangle<int> SpectrumAnalyserComponent::frameCallback() {
+    //worker skips this instance while hidden or unwatched, stale samples get dropped when it comes back
+    const bool showing = isShowing();
+    const auto nowMs = juce::Time::getMillisecondCounter();
+    const bool resumed = showing && (!wantsFrames.load() || isIdle(nowMs));
+    if (resumed) {
+        needsClear.store(true);
+    }
+    wantsFrames.store(showing);
+    lastPickupMs.store(nowMs);
+    if (!showing) {
+        return {};
+    }
+    //take the latest frame, if the worker is publishing right now it'll be there next tick
+    bool gotFrame = false;
+    {
+        const juce::SpinLock::ScopedTryLockType sl(frameLock);
+        if (sl.isLocked() && hasNewFrame) {
+            std::swap(readyFrame, uiFrame);
+            uiTraces = readyTraces;
+            hasNewFrame = false;
+            gotFrame = true;
+        }
+    }
+    if (gotFrame && onFrame && uiFrame.size() == (size_t)lastWidth * ANALYSER_TRACES) {
+        const int trace = (uiTraces & 0b010) ? 1 : 0;
+        onFrame(uiFrame.data() + trace * lastWidth, lastWidth);
+    }
+    //only what the traces moved through since the last pickup, nothing while they're at rest
+    juce::Rectangle<int> dirty;
+    {
+        const juce::ScopedTryLock sl(imageLock);
+        if (sl.isLocked()) {
+            dirty = pendingDirty;
+            pendingDirty = {};
+        }
+    }
+    return resumed ? getLocalBounds() : dirty;
+}
+
+void SpectrumAnalyserComponent::runAnalysis() {
     auto* fifo = audioProcessor.getAnalyserFifo();
     if (!fifo) {
         return;
     }
-    //on reset, mode change, state change, or sample rate change
-    if (needsClear.load()) {
+    //on reset, state change, or when the ring starts holding different streams
+    const int mode = analyserMode.load();
+    const int channel = analyserChannel.load();
+    const int layout = ringLayout(mode, channel);
+    if (needsClear.load() || layout != workLayout) {
         fifo->clear();
-        bufferPos = 0;
-        resetScopeData();
+        resetTaps();
+        //the hold trace doesn't mind a gap, only a change in what it's measuring
+        if (layout != workLayout) {
+            resetHold();
+        }
+        workLayout = layout;
         needsClear.store(false);
     }
-    //pop and accumulate
-    const int numRead = fifo->pop(sampleData + bufferPos, FFT_HOP_SIZE);
-    bufferPos += numRead;
-    //when accumulated
-    if (bufferPos >= FFT_SIZE) {
-        accumulatedBuffer();
-    }
-    repaint();
-}
-
-void SpectrumAnalyserComponent::accumulatedBuffer() {
-    //copy to fft scratch buffer
-    std::copy(sampleData, sampleData + FFT_SIZE, fftData);
-    //if new sample rate, update scalars and pixel bin buffers
-    double sr = audioProcessor.getSampleRate();
-    if (sr != lastSampleRate) {
-        lastSampleRate = sr;
-        computeBinScalars();
-        updatePixelFrequencyMapping(lastWidth);
-    }
-    //window and fft
-    window.multiplyWithWindowingTable(fftData, FFT_SIZE);
-    forwardFFT.performFrequencyOnlyForwardTransform(fftData);
-    //multiply by scalars
-    for (int i = 0; i < FFT_BIN_AMT; ++i) {
-        fftData[i] *= binScalars[i];
+    workTraces = tracesFor(mode, channel);
+    //hold follows post, or pre / left when post isn't drawn
+    const int average = analyserAverage.load();
+    const int tap = (workTraces & 0b010) ? 1 : 0;
+    if (average != workAverage || tap != holdTap) {
+        resetHold();
+        workAverage = average;
+        holdTap = tap;
+    }
+    if (average != ANALYSER_AVG_OFF) {
+        workTraces |= 1 << ANALYSER_HOLD_TRACE;
+    }
+    //if new sample rate, update decimation, scalars and pixel bin buffers
+    const double sr = audioProcessor.getSampleRate();
+    if (sr != lastSampleRate && sr > 1) {
+        updateSampleRate(sr);
+    }
+    //new width from resized
+    const int width = requestedWidth.load();
+    if (width != frameWidth) {
+        frameWidth = width;
+        updatePixelFrequencyMapping(width);
+    }
+    if (frameWidth < 2 || lastSampleRate <= 1) {
+        return;
+    }
+    //a new display scale only changes the image the traces are stroked into
+    workScale = renderScale.load();
+    //new size, ballistics start over at rest
+    const int height = requestedHeight.load();
+    if (pixelCurrent.size() != (size_t)frameWidth * ANALYSER_TRACES || height != workHeight) {
+        workHeight = height;
+        pixelCurrent.resize((size_t)frameWidth * ANALYSER_TRACES);
+        pixelTarget.resize(pixelCurrent.size());
+        resetScopeData();
+        renderedStyle = -1;
+    }
+    //only the kernels change, low pixels pick it up with the next low band frame
+    const int smoothing = analyserSmoothing.load();
+    if (smoothing != workSmoothing) {
+        workSmoothing = smoothing;
+        updateSmoothingKernels(frameWidth);
+    }
+    //fell behind by more than a hop, those still feed the low band but don't get their own frame
+    while (fifo->getNumReady() >= (FFT_SIZE + FFT_HOP_SIZE) * ANALYSER_TAPS) {
+        consumeHop(*fifo);
+    }
+    //build a frame once a full window of both taps is in
+    if (fifo->getNumReady() >= FFT_SIZE * ANALYSER_TAPS) {
+        accumulatedBuffer(*fifo);
+    }
+    //ballistics run every pass, new frame or not. nothing is drawn while the traces are at rest and look the same
+    const bool overlay = channel == ANALYSER_LR;
+    const bool withFill = fill.load();
+    const int style = workTraces | (overlay ? 1 << ANALYSER_TRACES : 0) | (withFill ? 2 << ANALYSER_TRACES : 0);
+    if (advancePixels() || style != renderedStyle) {
+        renderTraces(overlay, withFill);
+        renderedStyle = style;
+    }
+}
+
+void SpectrumAnalyserComponent::accumulatedBuffer(Fifo<float>& fifo) {
+    //only allocates when the width changed
+    workFrame.resize((size_t)frameWidth * ANALYSER_TRACES);
+    drawNextFrameOfSpectrum(fifo);
+    //consume one hop for 75% overlap
+    consumeHop(fifo);
+    //post over pre, a dB difference is the magnitude ratio
+    if (workTraces & (1 << ANALYSER_DELTA_TRACE)) {
+        juce::FloatVectorOperations::subtract(workFrame.data() + ANALYSER_DELTA_TRACE * frameWidth, workFrame.data() + frameWidth, workFrame.data(), frameWidth);
+    }
+    setPixelTargets();
+    publishFrame();
+}
+
+void SpectrumAnalyserComponent::drawNextFrameOfSpectrum(Fifo<float>& fifo) {
+    //the interleaved taps read straight in as (re, im) pairs, nothing is consumed until the frame is done
+    fifo.readWindow(reinterpret_cast<float*>(fftData), windowTable, FFT_SIZE * ANALYSER_TAPS, 0);
+    forwardFFT.perform(fftData, spectrum, false);
+    splitPackedSpectrum(spectrum, FFT_SIZE, binScalars, FFT_BIN_AMT, binPower[0], binPower[1]);
+    //pixels for freq > 1000 from the full rate frame
+    for (int t = 0; t < ANALYSER_TAPS; ++t) {
+        if (workTraces & (1 << t)) {
+            buildBand(false, binPower[t], workFrame.data() + t * frameWidth + firstHighPixel);
+        }
+    }
+    //hold accumulates per bin, so its pixels average the held power the same way the live ones do
+    float* hold = workFrame.data() + ANALYSER_HOLD_TRACE * frameWidth;
+    const bool holdOn = workTraces & (1 << ANALYSER_HOLD_TRACE);
+    if (holdOn) {
+        highHold.add(binPower[holdTap], workAverage, longAlpha);
+        buildBand(false, highHold.data(), hold + firstHighPixel);
+    }
+    //freq < 1000 comes from the low band, which keeps its last pixels until it has a new frame. reuses the fft buffers
+    updateLowBand();
+    for (int t = 0; t < ANALYSER_TAPS; ++t) {
+        if (workTraces & (1 << t)) {
+            std::copy(taps[t].lowPixelDb.begin(), taps[t].lowPixelDb.end(), workFrame.data() + t * frameWidth);
+        }
+    }
+    if (holdOn) {
+        std::copy(holdLowPixelDb.begin(), holdLowPixelDb.end(), hold);
+    }
+}
+
+void SpectrumAnalyserComponent::consumeHop(Fifo<float>& fifo) {
+    float* dest[ANALYSER_TAPS] = { taps[0].hop, taps[1].hop };
+    fifo.popFrames(dest, FFT_HOP_SIZE, ANALYSER_TAPS);
+    pushLowBand();
+}
+
+void SpectrumAnalyserComponent::publishFrame() {
+    //hand the frame over, old ready frame becomes the next work frame
+    const juce::SpinLock::ScopedLockType sl(frameLock);
+    std::swap(workFrame, readyFrame);
+    readyTraces = workTraces;
+    hasNewFrame = true;
+}
+
+void SpectrumAnalyserComponent::pushLowBand() {
+    //both decimators are always reset together, so they stay in step and give the same count
+    int numOut = 0;
+    for (auto& tap : taps) {
+        numOut = tap.decimator.process(tap.hop, FFT_HOP_SIZE);
+    }
+    lowFifo.pushInterleaved(taps[0].hop, taps[1].hop, numOut);
+}
+
+void SpectrumAnalyserComponent::updateLowBand() {
+    //low band hops come 1 / decimation as often, most passes this is a no-op
+    if (!lowFifo.readWindow(reinterpret_cast<float*>(fftData), windowTable, FFT_SIZE * ANALYSER_TAPS, FFT_HOP_SIZE * ANALYSER_TAPS)) {
+        return;
+    }
+    forwardFFT.perform(fftData, spectrum, false);
+    //scaled power of every bin a low pixel can touch
+    splitPackedSpectrum(spectrum, FFT_SIZE, lowBinScalars.data(), (int)lowBinScalars.size(), binPower[0], binPower[1]);
+    for (int t = 0; t < ANALYSER_TAPS; ++t) {
+        buildBand(true, binPower[t], taps[t].lowPixelDb.data());
     }
-    //draw new frame
-    drawNextFrameOfSpectrum();
-    //copy to get 75% overlap and use bufferPos to lose no samples
-    bufferPos = bufferPos - FFT_HOP_SIZE;
-    memmove(sampleData, sampleData + FFT_HOP_SIZE, bufferPos * sizeof(float));
+    //hold's low band accumulates at the low band frame rate
+    if (workAverage != ANALYSER_AVG_OFF) {
+        lowHold.add(binPower[holdTap], workAverage, lowLongAlpha);
+        buildBand(true, lowHold.data(), holdLowPixelDb.data());
+    }
+}
+
+void SpectrumAnalyserComponent::resetTaps() {
+    lowFifo.clear();
+    for (auto& tap : taps) {
+        tap.decimator.reset();
+        std::fill(tap.lowPixelDb.begin(), tap.lowPixelDb.end(), MIN_ANALYSIS_DB);
+    }
+}
+
+void SpectrumAnalyserComponent::resetHold() {
+    highHold.reset();
+    lowHold.reset();
+    std::fill(holdLowPixelDb.begin(), holdLowPixelDb.end(), MIN_ANALYSIS_DB);
+}
+
+void SpectrumAnalyserComponent::updateSampleRate(double sr) {
+    lastSampleRate = sr;
+    //largest power of two decimation that keeps the low band at or above LOW_BAND_MIN_RATE
+    int stages = 0;
+    while (stages < MAX_DECIMATION_STAGES && sr / (double)(2 << stages) >= LOW_BAND_MIN_RATE) {
+        ++stages;
+    }
+    for (auto& tap : taps) {
+        tap.decimator.setNumStages(stages);
+    }
+    lowFifo.clear();
+    lowSampleRate = sr / taps[0].decimator.getFactor();
+    //one frame per hop at each rate, 1 - e^(-t / T)
+    longAlpha = (float)(1.0 - std::exp(-(double)FFT_HOP_SIZE / (sr * ANALYSER_LONG_AVG_SECONDS)));
+    lowLongAlpha = (float)(1.0 - std::exp(-(double)FFT_HOP_SIZE / (lowSampleRate * ANALYSER_LONG_AVG_SECONDS)));
+    computeBinScalars();
+    updatePixelFrequencyMapping(frameWidth);
 }
 
 void SpectrumAnalyserComponent::computeBinScalars() {
@@ -80,142 +346,277 @@ void SpectrumAnalyserComponent::computeBinScalars() {
         float binFreq = (float)i * binMult;
         //simlified tilt function to remove log call
         float tilt = std::pow(binFreq / MID_FREQ, tiltExponent);
-        //scalar for each bin
-        binScalars[i] = tilt * pScale;
+        //scalar for each bin, squared since it's applied to power
+        binScalars[i] = (tilt * pScale) * (tilt * pScale);
+    }
+    //same for the low band, only up to the widest smoothing past MID_FREQ and a few bins more for the cubic
+    const float lowBinMult = lowSampleRate / (float)FFT_SIZE;
+    const int numLowBins = juce::jmin(FFT_BIN_AMT, (int)(MID_FREQ * ANALYSER_SMOOTH_REACH / lowBinMult) + 4);
+    lowBinScalars.resize(numLowBins);
+    lowBinDb.resize(numLowBins);
+    //held bins no longer line up, start over
+    highHold.reset();
+    lowHold.setSize(numLowBins);
+    for (int i = 0; i < numLowBins; ++i) {
+        const float scalar = std::pow((float)i * lowBinMult / MID_FREQ, tiltExponent) * pScale;
+        lowBinScalars[i] = scalar * scalar;
     }
 }
 
-void SpectrumAnalyserComponent::drawNextFrameOfSpectrum() {
-    auto h = (float)getHeight();
-    //for each pixel, either lerp based on surrounding bins for freq < 1000 or rms each bin in pixel area for freq > 1000
-    for (int i = 0; i < lastWidth; ++i) {
-        float dB;
-
-        if (i < firstHighPixel) {
-            dB = getLowFreqSmoothedValue(i, pixelBinIndices[i]);
-        }
-        else {
-            dB = getHighFreqSmoothedValues(i);
+void SpectrumAnalyserComponent::setPixelTargets() {
+    auto h = (float)workHeight;
+    for (int t = 0; t < ANALYSER_TRACES; ++t) {
+        if (!(workTraces & (1 << t))) {
+            continue;
         }
-        //map, clamp, then set to target (maps to y pixel pos)
-        auto level = juce::jmap(dB, MIN_ANALYSIS_DB, 0.0f, h, 0.0f);
-        level = juce::jlimit(0.0f, h, level);
-        pixelValues[i].setTargetValue(level);
+        //pre and post on the analyser scale, delta on the response curve's so it lines up with the filters
+        const bool delta = t == ANALYSER_DELTA_TRACE;
+        const float bottom = delta ? MIN_DB : MIN_ANALYSIS_DB;
+        const float top = delta ? MAX_DB : 0.0f;
+        //dB to y pixel pos is h * (top - dB) / (top - bottom), then clamp
+        const float scale = -h / (top - bottom);
+        float* target = pixelTarget.data() + t * frameWidth;
+        juce::FloatVectorOperations::multiply(target, workFrame.data() + t * frameWidth, scale, frameWidth);
+        juce::FloatVectorOperations::add(target, -top * scale, frameWidth);
+        juce::FloatVectorOperations::clip(target, target, 0.0f, h, frameWidth);
     }
 }
 
-float SpectrumAnalyserComponent::getLowFreqSmoothedValue(int pixelIndex, float centerBinFloat) {
-    //use fraction for mu in interp
-    int bin1 = (int)centerBinFloat;
-    float fraction = centerBinFloat - bin1;
-
-    int bin0 = juce::jmax(0, bin1 - 1);
-    int bin2 = juce::jmin(FFT_BIN_AMT - 1, bin1 + 1);
-    int bin3 = juce::jmin(FFT_BIN_AMT - 1, bin1 + 2);
-
-    //set bins to dB, hate doing this repeatedly, but it is what it is
-    float y0 = juce::Decibels::gainToDecibels(fftData[bin0], MIN_ANALYSIS_DB);
-    float y1 = juce::Decibels::gainToDecibels(fftData[bin1], MIN_ANALYSIS_DB);
-    float y2 = juce::Decibels::gainToDecibels(fftData[bin2], MIN_ANALYSIS_DB);
-    float y3 = juce::Decibels::gainToDecibels(fftData[bin3], MIN_ANALYSIS_DB);
-
-    //get 4 bins, interpolate
-    return cubicInterpolate(y0, y1, y2, y3, fraction);
+bool SpectrumAnalyserComponent::advancePixels() {
+    //fraction of the gap closed per pass. y is flipped, so a rising level is a falling y and gets the attack
+    const float attack = juce::jmin(1.0f, (float)FFT_ATTACK / (float)TIMER_FPS);
+    const float release = juce::jmin(1.0f, (float)FFT_RELEASE / (float)TIMER_FPS);
+    float* current = pixelCurrent.data();
+    const float* target = pixelTarget.data();
+    const size_t num = pixelCurrent.size();
+    //branchless so it vectorizes, tracking the largest gap left
+    float largest = 0.0f;
+    for (size_t i = 0; i < num; ++i) {
+        const float gap = target[i] - current[i];
+        current[i] += gap * (gap < 0.0f ? attack : release);
+        largest = juce::jmax(largest, std::abs(gap));
+    }
+    //under a tenth of a pixel wouldn't show
+    return largest > 0.1f;
 }
 
-float SpectrumAnalyserComponent::getHighFreqSmoothedValues(int pixelIndex) {    
-    //never overlap rms
-    int lowB = (int)pixelBinIndices[pixelIndex - 1] + 1;
-    int highB = (int)pixelBinIndices[pixelIndex];
-
-    //get root mean squared
-    float sumSq = 0.0f;
-    for (int i = lowB; i <= highB && i < FFT_BIN_AMT; ++i) {
-        sumSq += fftData[i] * fftData[i];
+void SpectrumAnalyserComponent::renderTraces(bool overlay, bool withFill) {
+    const int w = (frameWidth - 1) * downsample + 1;
+    const int imageW = juce::roundToInt((float)w * workScale);
+    const int imageH = juce::roundToInt((float)workHeight * workScale);
+    if (imageW < 1 || imageH < 1) {
+        return;
+    }
+    //paint blits its own handle to an image outside the lock, so the one the last publish handed back may still be being drawn. it holds
+    //a reference while it is, and only one, so the spare is free then
+    if (workImage.getReferenceCount() > 1) {
+        std::swap(workImage, spareImage);
+    }
+    //the image is the old size after a resize. software so it can be drawn off the message thread
+    if (workImage.getReferenceCount() > 1 || workImage.getWidth() != imageW || workImage.getHeight() != imageH) {
+        workImage = juce::Image(juce::Image::ARGB, imageW, imageH, true, juce::SoftwareImageType());
     }
-    float rms = std::sqrt(sumSq / (highB - lowB + 1));
-    //return as dB
-    return juce::Decibels::gainToDecibels(rms, MIN_ANALYSIS_DB);
+    else {
+        workImage.clear(workImage.getBounds());
+    }
+    //pre under post so post stays readable where they overlap, L+R gets its own pair of colours. hold is a lighter shade of its tap
+    const int tap = (workTraces & 0b010) ? 1 : 0;
+    const juce::Colour tapColours[ANALYSER_TAPS] = { overlay ? juce::Colours::cyan : juce::Colours::yellow,
+                                                     overlay ? juce::Colours::magenta : juce::Colours::lime };
+    const juce::Colour colours[ANALYSER_TRACES] = { tapColours[0], tapColours[1], juce::Colours::white, tapColours[tap].brighter(0.6f) };
+    const float h = (float)workHeight;
+    float top = h;
+    float bottom = 0.0f;
+    {
+        juce::Graphics g(workImage);
+        g.addTransform(juce::AffineTransform::scale(workScale));
+        for (int t = 0; t < ANALYSER_TRACES; ++t) {
+            if (!(workTraces & (1 << t))) {
+                continue;
+            }
+            //move x by downsample amount
+            const float* values = pixelCurrent.data() + t * frameWidth;
+            tracePath.clear();
+            tracePath.startNewSubPath(0, values[0]);
+            for (int i = 1; i < frameWidth; ++i) {
+                tracePath.lineTo((float)i * downsample, values[i]);
+            }
+            const auto range = juce::FloatVectorOperations::findMinAndMax(values, frameWidth);
+            top = juce::jmin(top, range.getStart());
+            bottom = juce::jmax(bottom, range.getEnd());
+            //fill under the live traces, fading out toward the floor
+            if (withFill && t < ANALYSER_TAPS) {
+                areaPath.clear();
+                areaPath.startNewSubPath(0, values[0]);
+                for (int i = 1; i < frameWidth; ++i) {
+                    areaPath.lineTo((float)i * downsample, values[i]);
+                }
+                areaPath.lineTo((float)(frameWidth - 1) * downsample, h);
+                areaPath.lineTo(0.0f, h);
+                areaPath.closeSubPath();
+                g.setGradientFill(juce::ColourGradient::vertical(colours[t].withAlpha(0.35f), 0.0f, colours[t].withAlpha(0.0f), h));
+                g.fillPath(areaPath);
+                bottom = h;
+            }
+            //draw the path
+            g.setColour(colours[t]);
+            g.strokePath(tracePath, juce::PathStrokeType(t == ANALYSER_HOLD_TRACE ? 1.0f : 2.0f, juce::PathStrokeType::curved));
+        }
+    }
+    //what changed on screen is where the traces are now plus where they were, with room for the stroke
+    juce::Rectangle<int> content;
+    if (top <= bottom) {
+        content = juce::Rectangle<float>(0.0f, top, (float)w, bottom - top).expanded(0.0f, 3.0f).getSmallestIntegerContainer();
+    }
+    publishImage(content.getUnion(lastContentBounds));
+    lastContentBounds = content;
 }
 
-float SpectrumAnalyserComponent::cubicInterpolate(float y0, float y1, float y2, float y3, float mu) {
-    //Catmull-Rom spline interpolation
-    float mu2 = mu * mu;
-    float a0 = -0.5f * y0 + 1.5f * y1 - 1.5f * y2 + 0.5f * y3;
-    float a1 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
-    float a2 = -0.5f * y0 + 0.5f * y2;
-    float a3 = y1;
-
-    return a0 * mu * mu2 + a1 * mu2 + a2 * mu + a3;
+void SpectrumAnalyserComponent::publishImage(juce::Rectangle<int> dirty) {
+    //finished image swaps in, the old ready one is drawn over next
+    const juce::ScopedLock sl(imageLock);
+    std::swap(workImage, readyImage);
+    readyScale = workScale;
+    pendingDirty = pendingDirty.getUnion(dirty);
 }
 
 void SpectrumAnalyserComponent::updatePixelFrequencyMapping(int width) {
-    //gets bin at each pixel for smoothing ops, and get first bin over MID_FREQ for branch in drawNextFrame
-    pixelBinIndices.resize(width);
-    bool firstHighPixelFound = false;
-
-    const float scale = FFT_SIZE / lastSampleRate;
-
+    //get first pixel over MID_FREQ for the low/full rate split
+    firstHighPixel = width;
     for (int i = 0; i < width; ++i) {
-        float normalized = (float)i / (float)(width - 1);
-        float freq = freqRange.convertFrom0to1(normalized);
-        if (!firstHighPixelFound && freq > MID_FREQ) {
+        if (freqRange.convertFrom0to1((float)i / (float)(width - 1)) > MID_FREQ) {
             firstHighPixel = i;
-            firstHighPixelFound = true;
+            break;
         }
-        float binIndexFloat = freq * scale;
+    }
+    //full rate pixels always rms, low band ones go cubic while bins are wider than pixels.
+    //low band stays 2 bins short of the last scaled one so the cubic never reads past it
+    mapPixelSpans(pixelSpans, firstHighPixel, width, width, FFT_SIZE / lastSampleRate, FFT_BIN_AMT - 1, false);
+    const int maxLowBin = juce::jmax(0, (int)lowBinScalars.size() - 3);
+    mapPixelSpans(lowPixelSpans, 0, firstHighPixel, width, FFT_SIZE / lowSampleRate, maxLowBin, true);
+    for (auto& tap : taps) {
+        tap.lowPixelDb.assign(firstHighPixel, MIN_ANALYSIS_DB);
+    }
+    holdLowPixelDb.assign(firstHighPixel, MIN_ANALYSIS_DB);
+    pixelPower.resize(juce::jmax(0, juce::jmax(firstHighPixel, width - firstHighPixel)));
+    updateSmoothingKernels(width);
+}
 
-        pixelBinIndices[i] = juce::jlimit(0.0f, (float)FFT_BIN_AMT - 1, binIndexFloat);
+void SpectrumAnalyserComponent::updateSmoothingKernels(int width) {
+    if (workSmoothing == ANALYSER_SMOOTH_OFF || lastSampleRate <= 1) {
+        pixelKernels.clear();
+        lowPixelKernels.clear();
+        return;
     }
+    //same split as the spans, each band smooths its own bins
+    mapPixelKernels(pixelKernels, firstHighPixel, width, width, FFT_SIZE / lastSampleRate, FFT_BIN_AMT - 1);
+    mapPixelKernels(lowPixelKernels, 0, firstHighPixel, width, FFT_SIZE / lowSampleRate, (int)lowBinScalars.size() - 1);
 }
 
-void SpectrumAnalyserComponent::paint(juce::Graphics& g) {
-    //no vals, no draw
-    if (pixelValues.empty()) return;
+void SpectrumAnalyserComponent::mapPixelKernels(std::vector<PixelKernel>& kernels, int first, int last, int width, float binsPerHz, int maxBin) {
+    kernels.resize(juce::jmax(0, last - first));
+    //edges half the smoothing width either side of the pixel's frequency
+    const float reach = std::exp2(0.5f * ANALYSER_SMOOTH_OCTAVES[workSmoothing]);
+    for (int i = first; i < last; ++i) {
+        const float center = freqRange.convertFrom0to1((float)i / (float)(width - 1)) * binsPerHz;
+        auto& kernel = kernels[i - first];
+        kernel.lo = juce::jlimit(0.0f, (float)maxBin, center / reach);
+        kernel.hi = juce::jlimit(0.0f, (float)maxBin, center * reach);
+    }
+}
 
-    //use helper to get next smoothed value and move x by downsample amount
-    juce::Path path;
-    path.startNewSubPath(0, getSmoothedValue(pixelValues[0]));
-    for (int i = 1; i < pixelValues.size(); ++i) {
-        path.lineTo((float)i * downsample, getSmoothedValue(pixelValues[i]));
+void SpectrumAnalyserComponent::smoothPixels(const std::vector<PixelKernel>& kernels, const float* power, int numBins, float* dest) {
+    //trapezoid running sum, the integral of the power interpolated linearly between bin centres
+    binIntegral[0] = 0.0;
+    for (int k = 1; k < numBins; ++k) {
+        binIntegral[k] = binIntegral[k - 1] + 0.5 * ((double)power[k - 1] + (double)power[k]);
+    }
+    auto integralAt = [&](float x) {
+        const int k = juce::jmin((int)x, numBins - 2);
+        const double mu = (double)(x - (float)k);
+        const double p = power[k];
+        return binIntegral[k] + mu * (p + 0.5 * mu * ((double)power[k + 1] - p));
+    };
+    //mean over each kernel costs two reads whatever its width. one narrower than a bin (lowest pixels at fine smoothing) is just the
+    //interpolated power, which keeps the low end as smooth as the cubic did
+    const int num = (int)kernels.size();
+    for (int i = 0; i < num; ++i) {
+        const auto& kernel = kernels[i];
+        const float width = kernel.hi - kernel.lo;
+        if (width > 1.0e-3f) {
+            pixelPower[i] = (float)((integralAt(kernel.hi) - integralAt(kernel.lo)) / (double)width);
+        }
+        else {
+            const int k = juce::jmin((int)kernel.lo, numBins - 2);
+            const float mu = kernel.lo - (float)k;
+            pixelPower[i] = power[k] + mu * (power[k + 1] - power[k]);
+        }
+    }
+    powerToDecibels(dest, pixelPower.data(), num, MIN_ANALYSIS_DB);
+}
+
+void SpectrumAnalyserComponent::buildBand(bool low, const float* power, float* dest) {
+    if (workSmoothing != ANALYSER_SMOOTH_OFF) {
+        smoothPixels(low ? lowPixelKernels : pixelKernels, power, low ? (int)lowBinScalars.size() : FFT_BIN_AMT, dest);
+    }
+    else if (low) {
+        //cubic pixels read the bins in dB
+        powerToDecibels(lowBinDb.data(), power, (int)lowBinDb.size(), MIN_ANALYSIS_DB);
+        buildSpanPixels(lowPixelSpans.data(), (int)lowPixelSpans.size(), power, lowBinDb.data(), pixelPower.data(), dest);
+    }
+    else {
+        buildSpanPixels(pixelSpans.data(), (int)pixelSpans.size(), power, nullptr, pixelPower.data(), dest);
+    }
+}
+
+void SpectrumAnalyserComponent::paint(juce::Graphics& g) {
+    //a ui scale or display change doesn't resize, so the worker is handed the scale this is actually drawn at
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (scale != renderScale.load()) {
+        renderScale.store(scale);
+    }
+    //take a handle to the worker's last finished image under the lock and blit it, back to logical size, after. the worker never waits
+    //on a draw, only on this copy
+    juce::Image image;
+    float imageScale = 1.0f;
+    {
+        const juce::ScopedLock sl(imageLock);
+        image = readyImage;
+        imageScale = readyScale;
+    }
+    if (image.isValid()) {
+        g.drawImageTransformed(image, juce::AffineTransform::scale(1.0f / imageScale));
     }
-    //draw the path
-    g.setColour(lineColor);
-    g.strokePath(path, juce::PathStrokeType(2.0f, juce::PathStrokeType::curved));
 }
 
 void SpectrumAnalyserComponent::resized() {
     //downsample pixels to divide the expense
     int width = getWidth() / downsample + 1;
-    //if new, reset smoooth vals and pixel map
+    //if new, the worker rebuilds its pixel mapping and resets its ballistics on the next run
     if (width != lastWidth) {
         lastWidth = width;
-
-        pixelValues.resize(width);
-
-        resetScopeData();
-
-        updatePixelFrequencyMapping(width);
+        requestedWidth.store(width);
     }
-    //set up a clear in timer callback
+    //drawn at the display's scale so the blit is 1:1
+    requestedHeight.store(getHeight());
+    renderScale.store(juce::Component::getApproximateScaleFactorForComponent(this));
+    //set up a clear on the worker
     needsClear.store(true);
 }
 
-void SpectrumAnalyserComponent::resetScopeData() {
-    //reset ramp, current, and target in all values
-    auto h = getHeight();
-    for (auto& value : pixelValues) {
-        value.reset(TIMER_FPS);
-        value.setCurrentAndTargetValue(h);
+void SpectrumAnalyserComponent::visibilityChanged() {
+    //turning the analyser off stops its work right away, the timer picks it back up when shown
+    if (!isVisible()) {
+        wantsFrames.store(false);
     }
 }
 
-float SpectrumAnalyserComponent::getSmoothedValue(juce::SmoothedValue<float>& value) {
-    //separate attack and release values, backwards to account for y pixel positioning
-    if (value.getCurrentValue() < value.getTargetValue()) {
-        return value.skip(FFT_RELEASE);
-    }
-    else {
-        return value.skip(FFT_ATTACK);
-    }
+void SpectrumAnalyserComponent::resetScopeData() {
+    //reset current and target in all values
+    //everything rests at the bottom apart from delta, which rests at 0 dB on the response curve's scale
+    auto h = (float)workHeight;
+    const float deltaRest = juce::jmap(0.0f, MIN_DB, MAX_DB, h, 0.0f);
+    std::fill(pixelCurrent.begin(), pixelCurrent.end(), h);
+    std::fill_n(pixelCurrent.begin() + ANALYSER_DELTA_TRACE * frameWidth, frameWidth, deltaRest);
+    pixelTarget = pixelCurrent;
 }
@@ -3,74 +3,218 @@
 
 #include <JuceHeader.h>
 #include "Utils/Constants.h"
+#include "Utils/AnalysisWorker.h"
+#include "Utils/VisualizerProcesing.h"
 class SemiProQAudioProcessor;
 
 //==============================================================================
-/** Spectrum Analyser with rms for high end and interpolation for low end
+/** Spectrum Analyser with rms for high end and interpolation for low end, or fractional octave smoothing across both. The fft and frame building run on the shared AnalysisWorker,
+    the message thread only picks up finished frames and draws them. Below MID_FREQ it draws from a decimated low band run through the
+    same size fft, so the low end gets ~1.4 Hz bins at any sample rate for about 1 / decimation of an extra fft. The ring carries two streams
+    (pre and post of one channel, or left and right for L+R) that are packed into one complex fft as a + ib, so two traces cost about
+    what one real transform did. The worker also runs the ballistics and strokes the traces into an image, so paint only blits that image
+    and only the area the traces moved through gets repainted
 */
-struct SpectrumAnalyserComponent : juce::Component {
+struct SpectrumAnalyserComponent : juce::Component, AnalysisClient {
     SpectrumAnalyserComponent(SemiProQAudioProcessor&);
-    ~SpectrumAnalyserComponent();
+    ~SpectrumAnalyserComponent() override;
 
-    //pull from fifo and see if able to draw
-    void timerCallback();
+    //take the latest frame from the worker, returns the area its image changed since the last pickup
+    juce::Rectangle<int> frameCallback();
+    //worker thread: pull from fifo and build a frame when a hop is ready
+    void runAnalysis() override;
+
+    //ANALYSER_PRE to ANALYSER_DELTA, picked up by the worker on its next pass
+    void setMode(int mode);
+    //ANALYSER_MID to ANALYSER_LR, same
+    void setChannel(int channel);
+    //ANALYSER_AVG_OFF to ANALYSER_AVG_INTEGRATED, a new mode starts its accumulation over
+    void setAverage(int average);
+    //gradient fill under the pre and post traces
+    void setFill(bool shouldFill);
+    //ANALYSER_SMOOTH_OFF to 1/1 octave, the worker rebuilds its kernels on the next pass
+    void setSmoothing(int smoothing);
 
-    juce::Colour lineColor;
     std::atomic<bool> needsClear{ false };
+    //message thread, called with the main trace of every new frame (post, or pre / left when post isn't drawn)
+    std::function<void(const float* frameDb, int num)> onFrame;
 
 private:
+    //smoothing window of a pixel as fractional bin positions. the box from lo to hi over the linearly interpolated bin power is a banded
+    //weight row with a constant inside and partial weights at its edges, so only the edges are stored
+    struct PixelKernel {
+        float lo = 0.0f;
+        float hi = 0.0f;
+    };
+
     void paint(juce::Graphics& g) override;
     void resized() override;
+    void visibilityChanged() override;
 
-    //op when buffer full
-    void accumulatedBuffer();
-    //get all the y pixels for each pixel position
-    void drawNextFrameOfSpectrum();
+    //per stream state on the worker, pre (or left) is tap 0 and post (or right) is tap 1
+    struct Tap {
+        //raw samples of the hop just consumed, decimated in place for the low band
+        float hop[FFT_HOP_SIZE];
+        DecimatorCascade decimator;
+        //dB of the low pixels, only rebuilt when the low band has a new frame
+        std::vector<float> lowPixelDb;
+    };
+
+    //op when a full window of both taps is ready
+    void accumulatedBuffer(Fifo<float>& fifo);
+    //fft both taps at once and put the dB of each pixel position into the drawn traces of the work frame
+    void drawNextFrameOfSpectrum(Fifo<float>& fifo);
+    //consume one hop of both taps and feed them to the low band
+    void consumeHop(Fifo<float>& fifo);
+    //hand the work frame to the message thread
+    void publishFrame();
+    //set ballistics targets from the work frame
+    void setPixelTargets();
+    //move every pixel one pass toward its target, attack going up and release coming down. false once nothing is visibly moving
+    bool advancePixels();
+    //stroke the drawn traces into the work image and publish it
+    void renderTraces(bool overlay, bool withFill);
+    //hand the work image to paint along with the area that changed since the last one
+    void publishImage(juce::Rectangle<int> dirty);
+    //decimate the hops just consumed and queue them for the low band
+    void pushLowBand();
+    //fft the low band when it has a new hop and rebuild both taps' low pixels from it
+    void updateLowBand();
+    //drop the low band history, on clears and when the ring's streams change
+    void resetTaps();
+    //start the hold trace over
+    void resetHold();
+    //pick the decimation for a new sample rate and redo everything sized by it
+    void updateSampleRate(double sr);
     //precompute frequency-to-bin mapping for each pixel
     void updatePixelFrequencyMapping(int w);
-    //scale based on window loss, fft norm, and tilt factor for music
+    //smoothing kernels of both bands for the current width and smoothing, empty while it's off
+    void updateSmoothingKernels(int width);
+    //kernels for pixels first to last at binsPerHz, clamped to maxBin
+    void mapPixelKernels(std::vector<PixelKernel>& kernels, int first, int last, int width, float binsPerHz, int maxBin);
+    //mean power under each kernel read off a running integral, then one dB pass
+    void smoothPixels(const std::vector<PixelKernel>& kernels, const float* power, int numBins, float* dest);
+    //pixels of the low band or full rate band from bin power, smoothed or raw
+    void buildBand(bool low, const float* power, float* dest);
+    //power scale based on window loss, fft norm, and tilt factor for music
     void computeBinScalars();
-    //reset scope data on sample rate change or spec config change
+    //rest every pixel at the bottom, on size changes
     void resetScopeData();
-    //helper to decide how fast rate should be based on whether the value is lowering or rising
-    float getSmoothedValue(juce::SmoothedValue<float>& value);
-    //gets scope y pixel value for pixels < 1000 hz using cubic interpolation
-    float getLowFreqSmoothedValue(int pixelIndex, float centerBinFloat);
-    //gets scope y pixel value for pixels >= 1000 hz using rms
-    float getHighFreqSmoothedValues(int pixelIndex);
-    //cubic helper for getLowFreq function
-    float cubicInterpolate(float y0, float y1, float y2, float y3, float mu);
 
     SemiProQAudioProcessor& audioProcessor;
+    //one worker for every instance in the process
+    juce::SharedResourcePointer<AnalysisWorker> worker;
     juce::dsp::FFT forwardFFT;
-    juce::dsp::WindowingFunction<float> window;
 
-    //including buffer in fifo these all amount to ~160 kB now. (FFT_SIZE * sizeof(float) * (4 + 2 * (HOP_SIZE / FFT_SIZE) + .5(FFT_BIN_AMT))
-    //Ring buffer that handles fifo and sampleData logic would add a ton of complexity and thread safety issues, but it could chop 40 kB off of this
+    //including the processor's fifo ring these all amount to ~520 kB now. (FFT_SIZE * sizeof(float) * (2 + 4 + 2 + 2 + 1 + 2.5 + 0.5) + 16 * FFT_BIN_AMT)
+    //that's up from ~160 kB for the two taps, complex fft, low band ring, smoothing integral, and hold accumulators. frames are window-read
+    //straight out of the fifo rings, so there is no sample buffer to copy into and memmove every hop: 40 kB less per stream than the old
+    //sampleData, 160 kB less than copying both taps of both bands that way. static_asserts in the .cpp hold sizeof to these arrays plus
+    //16 kB and check that a layout with sampleData back in can't meet that
+    //a second analyser instance would double all of it
 
-    //sample buffer with hopping logic
-    float sampleData[FFT_SIZE + FFT_HOP_SIZE];
-    //fft processing buffer
-    float fftData[FFT_SIZE * 2];
-    //saved value of each pixel's scaling and tilt. I don't love this tradeoff. Cache 4097 floats or compute this every new frame
+    //WORKER THREAD ONLY
+    //hann table with every point twice, applied to (re, im) pairs while reading out of the rings
+    float windowTable[FFT_SIZE * 2];
+    //packed fft input and its spectrum, juce's complex transform doesn't run in place
+    juce::dsp::Complex<float> fftData[FFT_SIZE];
+    juce::dsp::Complex<float> spectrum[FFT_SIZE];
+    //power of each tap per bin, split out of the spectrum
+    float binPower[ANALYSER_TAPS][FFT_BIN_AMT];
+    //saved value of each pixel's power scaling and tilt. I don't love this tradeoff. Cache 4097 floats or compute this every new frame
     float binScalars[FFT_BIN_AMT];
+    //integral of one tap's power up to each bin for the smoothing kernels, double since quiet highs sit on top of loud lows
+    double binIntegral[FFT_BIN_AMT];
+    Tap taps[ANALYSER_TAPS];
+    //decimated low band of both taps, interleaved the same as the main ring so it gets packed the same way
+    Fifo<float> lowFifo{ (FFT_SIZE + FFT_HOP_SIZE) * ANALYSER_TAPS };
+    //hold trace accumulation of the main tap's full rate and low band bins
+    SpectrumAccumulator highHold, lowHold;
+    //dB of the hold trace's low pixels, rebuilt with the low band
+    std::vector<float> holdLowPixelDb;
+    //per frame ANALYSER_AVG_LONG coefficients at the full and low band frame rates
+    float longAlpha = 1.0f;
+    float lowLongAlpha = 1.0f;
+    //hold mode and the tap it follows, either changing starts it over
+    int workAverage = ANALYSER_AVG_OFF;
+    int holdTap = 1;
+    //low band bins only up to the widest smoothing's reach past MID_FREQ are ever used
+    std::vector<float> lowBinScalars;
+    //dB of those low bins, converted once per low frame for the cubic
+    std::vector<float> lowBinDb;
+    //averaged power per pixel before the dB pass
+    std::vector<float> pixelPower;
 
     //pixel-based arrays (dynamically sized based on component width / downsampling + hasModulo) at max width (1093) and downsampling = 2,
-    //sizes are 547 and costs (547 * 24 bytes)(24 is from sizes: float + SmoothValue) + (24 * 2) bytes from ptrs per vec,  ~12kb
-
-    //corresponding FFT bin index (float for interpolation)
-    std::vector<float> pixelBinIndices;
-    //smoothed output values
-    std::vector<juce::SmoothedValue<float>> pixelValues;
+    //sizes are 547 and costs (547 * 24 bytes)(24 is from sizes: float + PixelSpan) + (24 * 2) bytes from ptrs per vec,  ~12kb. ballistics keep
+    //two floats per pixel per trace, ~17kb at max width
 
-    //buffer pos signals when new frame is available
-    int bufferPos = 0;
+    //full rate spans for pixels from firstHighPixel up
+    std::vector<PixelSpan> pixelSpans;
+    //low band spans for pixels below firstHighPixel
+    std::vector<PixelSpan> lowPixelSpans;
+    //smoothing kernels for the same pixels, and the smoothing they were built for
+    std::vector<PixelKernel> pixelKernels;
+    std::vector<PixelKernel> lowPixelKernels;
+    int workSmoothing = ANALYSER_SMOOTH_OFF;
+    //dB per pixel being built, ANALYSER_TRACES traces of frameWidth (pre, post, delta)
+    std::vector<float> workFrame;
+    //traces the work frame was built for, one bit per trace
+    int workTraces = 0;
+    //what the ring held on the last pass
+    int workLayout = -1;
     //cached sample rate
     double lastSampleRate = 0.0;
+    //lastSampleRate / decimation
+    double lowSampleRate = 0.0;
+    //width the pixel mapping was built for
+    int frameWidth = 0;
+    //first pixel at freq above 1000hz, everything under it comes from the low band
+    int firstHighPixel = 0;
+    //drawn y and the y it's heading for, ANALYSER_TRACES traces of frameWidth
+    std::vector<float> pixelCurrent;
+    std::vector<float> pixelTarget;
+    //height and display scale the pixels and image were set up for
+    int workHeight = 0;
+    float workScale = 1.0f;
+    //image being drawn, reallocated only when the size changes. the spare takes over while paint still holds the last one, so with the
+    //ready image that's three at most
+    juce::Image workImage;
+    juce::Image spareImage;
+    //kept between renders so their storage is reused
+    juce::Path tracePath, areaPath;
+    //area the traces covered in the last image, and what that image was drawn with
+    juce::Rectangle<int> lastContentBounds;
+    int renderedStyle = -1;
+
+    //SHARED. frames are handed over by swapping vectors under the spin lock, so nothing is copied or allocated to publish one
+    juce::SpinLock frameLock;
+    //last finished frame and its traces, guarded by frameLock
+    std::vector<float> readyFrame;
+    int readyTraces = 0;
+    bool hasNewFrame = false;
+    //width / downsample + 1, height, and display scale, set by resized() and picked up by the worker
+    std::atomic<int> requestedWidth{ 0 };
+    std::atomic<int> requestedHeight{ 0 };
+    std::atomic<float> renderScale{ 1.0f };
+    std::atomic<bool> fill{ false };
+    //last finished image, its scale, and the area changed since paint last picked one up. paint holds imageLock only to copy the image
+    //handle, the worker only to swap
+    juce::CriticalSection imageLock;
+    juce::Image readyImage;
+    float readyScale = 1.0f;
+    juce::Rectangle<int> pendingDirty;
+    std::atomic<int> analyserMode{ ANALYSER_POST };
+    std::atomic<int> analyserChannel{ ANALYSER_MID };
+    std::atomic<int> analyserAverage{ ANALYSER_AVG_OFF };
+    std::atomic<int> analyserSmoothing{ ANALYSER_SMOOTH_OFF };
+
+    //MESSAGE THREAD ONLY
+    //latest frame and its traces, for onFrame
+    std::vector<float> uiFrame;
+    int uiTraces = 0;
     //cached width / downsample + 1
     int lastWidth = 0;
-    //downsample how may pixels are processed
-    int downsample = 2;
-    //first pixel at freq above 1000hz
-    int firstHighPixel = 0;
+    //downsample how may pixels are processed, never changes so the worker reads it too
+    const int downsample = 2;
 };
\ No newline at end of file
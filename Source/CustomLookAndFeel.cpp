@@ -117,12 +117,12 @@ void CustomLookAndFeelB::drawButtonBackground(Graphics& g, Button& b, const Colo
     g.strokePath(cross, PathStrokeType(5.0f));
 }
 
-void CustomLookAndFeelC::drawButtonBackground(Graphics& g, Button& b, const Colour&, bool shouldDrawButtonAsHighlighted, bool shouldDrawButtonAsDown) {
+void CustomLookAndFeelC::drawButtonBackground(Graphics& g, Button& b, const Colour& backgroundColour, bool shouldDrawButtonAsHighlighted, bool shouldDrawButtonAsDown) {
     auto bounds = b.getLocalBounds().toFloat();
 
     bool isPost = b.getToggleState();
-
-    Colour base = isPost ? Colours::limegreen : Colours::yellow;
+    //buttons with more than two states set their own text and colour
+    Colour base = b.getButtonText().isNotEmpty() ? backgroundColour : isPost ? Colours::limegreen : Colours::yellow;
 
     if (shouldDrawButtonAsHighlighted) {
         base = base.brighter(COLOR_CHANGE);
@@ -142,7 +142,7 @@ void CustomLookAndFeelC::drawButtonText(Graphics& g, TextButton& button, bool, b
     auto bounds = button.getLocalBounds();
     bool isPost = button.getToggleState();
 
-    String text = isPost ? "POST" : "PRE";
+    String text = button.getButtonText().isNotEmpty() ? button.getButtonText() : isPost ? "POST" : "PRE";
 
     g.setColour(Colours::black);
     g.setFont(Font(16.0f, Font::bold));
@@ -66,3 +66,13 @@ struct CustomLookAndFeelF : LookAndFeel_V4 {
     void fillTextEditorBackground(Graphics&, int width, int height, TextEditor&) override;
     void drawTextEditorOutline(Graphics&, int width, int height, TextEditor&) override;
 };
+
+//One of each, shared by every open editor through juce::SharedResourcePointer so opening another editor doesn't build them again
+struct EditorLookAndFeels {
+    CustomLookAndFeelA a;
+    CustomLookAndFeelB b;
+    CustomLookAndFeelC c;
+    CustomLookAndFeelD d;
+    CustomLookAndFeelE e;
+    CustomLookAndFeelF f;
+};
@@ -6,20 +6,24 @@
 /** Parent editor component of all GUI elements
 */
 SemiProQAudioProcessorEditor::SemiProQAudioProcessorEditor(SemiProQAudioProcessor& p) : AudioProcessorEditor(&p), audioProcessor(p), 
-      selectedFilterComponent(audioProcessor, *this, -1, 0, lnfb, lnfd), responseCurveComponent(audioProcessor), analyserComponent(audioProcessor), 
+      selectedFilterComponent(audioProcessor, *this, -1, 0, lnfb, lnfd), responseCurveComponent(audioProcessor), analyserComponent(audioProcessor), nodeOverlay(audioProcessor, *this), 
       gainComponent(audioProcessor, *this, lnfd), peakComponent(audioProcessor), settingsComponent(audioProcessor, *this, lnfc, lnfd, lnfe) {
     //current aspect ratio = 16 / 9
     setSize(MAIN_WINDOW_WIDTH, MAIN_WINDOW_HEIGHT);
 
-    //draggable button bounding box
+    //band node bounding box
     buttonBounds = getRenderArea();
 
-    //cached bg
-    backgroundImage();
-
     //resize and set up anaylser, peak meters, and response curve
     resizeVisualizers();
+    addChildComponent(spectrogramComponent);
     addAndMakeVisible(analyserComponent);
+    //spectrogram rows come from the analyser's frames, so it only runs while the analyser does
+    analyserComponent.onFrame = [this](const float* frameDb, int num) {
+        if (spectrogramComponent.isVisible()) {
+            spectrogramComponent.pushFrame(frameDb, num);
+        }
+    };
     addAndMakeVisible(responseCurveComponent);
     addAndMakeVisible(peakComponent);
     audioProcessor.setCurveStatus(true);
@@ -31,10 +35,17 @@ SemiProQAudioProcessorEditor::SemiProQAudioProcessorEditor(SemiProQAudioProcesso
     referAndAddListener(minSettings, MINIMIZE_SETTINGS);
     referAndAddListener(analyserOnValue, ANALYSER_ON);
     referAndAddListener(analyserModeValue, ANALYSER_MODE);
+    referAndAddListener(analyserChannelValue, ANALYSER_CHANNEL);
+    referAndAddListener(spectrogramOnValue, SPECTROGRAM_ON);
+    referAndAddListener(analyserAverageValue, ANALYSER_AVERAGE);
+    referAndAddListener(analyserFillValue, ANALYSER_FILL);
+    referAndAddListener(analyserSmoothingValue, ANALYSER_SMOOTHING);
+    referAndAddListener(curveTracesValue, CURVE_TRACES);
+    referAndAddListener(uiScaleValue, UI_SCALE);
     referAndAddListener(peakOnValue, PEAK_ON);
     referAndAddListener(peakModeValue, PEAK_MODE);
 
-    setupDraggableButtons();
+    setupBandNodes();
 
     //setup minimizable and draggable components
     setupMinimizableComp(settingsComponent, minSettings);
@@ -45,17 +56,24 @@ SemiProQAudioProcessorEditor::SemiProQAudioProcessorEditor(SemiProQAudioProcesso
     selectedFilterChanged();
     analyserOnChanged();
     analyserModeChanged();
+    analyserChannelChanged();
+    spectrogramOnChanged();
+    analyserAverageChanged();
+    analyserFillChanged();
+    analyserSmoothingChanged();
+    curveTracesChanged();
     peakOnChanged();
     peakModeChanged();
+    uiScaleChanged();
 
     tooltipWindow.setOpaque(false);
 
-    startTimerHz(TIMER_FPS);
+    vblank = juce::VBlankAttachment(this, [this]() { onVBlank(); });
 }
 
 SemiProQAudioProcessorEditor::~SemiProQAudioProcessorEditor() {
-    //stop timer, remove weak refs, and remove listeners
-    stopTimer();
+    //stop frames, remove weak refs, and remove listeners
+    vblank = {};
 
     settingsComponent.setLookAndFeel(nullptr);
     selectedFilterComponent.setLookAndFeel(nullptr);
@@ -68,45 +86,69 @@ SemiProQAudioProcessorEditor::~SemiProQAudioProcessorEditor() {
 
     analyserOnValue.removeListener(this);
     analyserModeValue.removeListener(this);
+    analyserChannelValue.removeListener(this);
+    spectrogramOnValue.removeListener(this);
+    analyserAverageValue.removeListener(this);
+    analyserFillValue.removeListener(this);
+    analyserSmoothingValue.removeListener(this);
+    curveTracesValue.removeListener(this);
+    uiScaleValue.removeListener(this);
     peakOnValue.removeListener(this);
     peakModeValue.removeListener(this);
 }
 
 //==============================================================================
 void SemiProQAudioProcessorEditor::paint(juce::Graphics& g) {
-    g.drawImage(background, getLocalBounds().toFloat());
+    auto& layer = background->forScale(g.getInternalContext().getPhysicalPixelScaleFactor());
+    const bool ready = backgroundDue || layer.isCurrent(g, *this);
+    //with nothing cached at this scale yet, the first frame goes up without the grid and it's rendered on the repaint after. that
+    //repaint is posted, not threaded, so the grid still renders on the message thread, just after the controls are up
+    if (!firstPainted) {
+        firstPainted = true;
+        if (!ready) {
+            juce::MessageManager::callAsync([safe = juce::Component::SafePointer<SemiProQAudioProcessorEditor>(this)]() {
+                if (safe != nullptr) {
+                    safe->backgroundDue = true;
+                    safe->repaint();
+                }
+            });
+        }
+    }
+    if (!ready) {
+        g.fillAll(juce::Colours::black);
+        return;
+    }
+    backgroundDue = true;
+    layer.draw(g, *this, [this](juce::Graphics& bg) { paintBackground(bg); });
 }
 
-//rescale background, set bounds for analyser, response curve, and peak area
+//set bounds for analyser, response curve, and peak area. the background follows the new size on its next paint
 void SemiProQAudioProcessorEditor::resized() {
-    background = background.rescaled(getLocalBounds().getWidth(), getLocalBounds().getHeight(), juce::Graphics::mediumResamplingQuality);
-
     resizeVisualizers();
 }
 
+void SemiProQAudioProcessorEditor::setScaleFactor(float newScale) {
+    hostScale = newScale;
+    uiScaleChanged();
+}
+
 //==============================================================================
 // PRIMARY FUNCTIONALITY
-//makes draggable button visible on double click and initializes filter to click position, then sets as selected filter
+//shows a band node on double click and initializes filter to click position, then sets as selected filter
 void SemiProQAudioProcessorEditor::mouseDoubleClick(const juce::MouseEvent& event) {
     auto mousePos = event.getPosition();
     if (!buttonBounds.contains(mousePos))
         return;
 
-    //finds first uninitialized filter, sets position, updates the filter's params, sets the init property in tree, update bypass, 
-    //set prior and new filter for repaint, update selectedFilterValue, and set new filter button to visible
+    //finds first uninitialized filter, sets the filter's params from the position, sets the init property in tree, update bypass, 
+    //update selectedFilterValue, and show the new node. the overlay repaints the prior and new selection on the next frame
     for (int i = 0; i < MAX_FILTERS; ++i) {
         if (!audioProcessor.tree.state[props[i]]) {
-            buttonArr[i]->setCentrePosition(mousePos);
-            buttonArr[i]->updateParamsFromPosition();
+            nodeOverlay.placeNode(i, nodeOverlay.getLocalPoint(this, mousePos));
             audioProcessor.tree.state.setProperty(props[i], true, nullptr);
             audioProcessor.updateParameter(i, BYPASS, false);
-            int val = selectedFilterValue.getValue();
-            if (val != -1) {
-                buttonArr[selectedFilterValue.getValue()]->needsRepaint.store(true);
-            }
             selectedFilterValue.setValue(i);
-            buttonArr[i]->setVisible(true);
-            buttonArr[i]->needsRepaint.store(true);
+            nodeOverlay.setNodeActive(i, true);
             return;
         }
     }
@@ -114,18 +156,17 @@ void SemiProQAudioProcessorEditor::mouseDoubleClick(const juce::MouseEvent& even
     juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon, "Maximum Filter Limit Reached", "The limit of filters is 12.");
 }
 
-//reset button on right click and run vis check for Selected Filter Component
+//reset button on right click and run vis check for Selected Filter Component. The bypass marks the curve dirty, which repaints just that band
 void SemiProQAudioProcessorEditor::buttonReset(int id) {
     audioProcessor.resetEq(id);
-    buttonArr[id]->setVisible(false);
+    nodeOverlay.setNodeActive(id, false);
     sfcVisiblityCheck();
-    responseCurveComponent.repaint();
 }
 
 //checks if an eq is initialized, if so makes the highest indexed initialized eq selected if no others are selected, else set visibility false
 void SemiProQAudioProcessorEditor::sfcVisiblityCheck() {
     for (int i = MAX_FILTERS - 1; i >= 0; --i) {
-        if (buttonArr[i]->isVisible()) {
+        if (nodeOverlay.isNodeActive(i)) {
             selectedFilterValue.setValue(i);
             return;
         }
@@ -160,6 +201,34 @@ void SemiProQAudioProcessorEditor::valueChanged(juce::Value& value) {
     else if (value.refersToSameSourceAs(analyserModeValue)) {
         analyserModeChanged();
     }
+    //analyser channel button pressed
+    else if (value.refersToSameSourceAs(analyserChannelValue)) {
+        analyserChannelChanged();
+    }
+    //spectrogram button pressed
+    else if (value.refersToSameSourceAs(spectrogramOnValue)) {
+        spectrogramOnChanged();
+    }
+    //analyser average button pressed
+    else if (value.refersToSameSourceAs(analyserAverageValue)) {
+        analyserAverageChanged();
+    }
+    //analyser fill button pressed
+    else if (value.refersToSameSourceAs(analyserFillValue)) {
+        analyserFillChanged();
+    }
+    //analyser smoothing button pressed
+    else if (value.refersToSameSourceAs(analyserSmoothingValue)) {
+        analyserSmoothingChanged();
+    }
+    //curve traces button pressed
+    else if (value.refersToSameSourceAs(curveTracesValue)) {
+        curveTracesChanged();
+    }
+    //ui scale button pressed
+    else if (value.refersToSameSourceAs(uiScaleValue)) {
+        uiScaleChanged();
+    }
     //peak on button pressed
     else if (value.refersToSameSourceAs(peakOnValue)) {
         peakOnChanged();
@@ -173,10 +242,9 @@ void SemiProQAudioProcessorEditor::valueChanged(juce::Value& value) {
 void SemiProQAudioProcessorEditor::selectedFilterChanged() {
     int id = selectedFilterValue.getValue();
 
-    if (id > -1 && id < buttonArr.size()) {
+    if (id > -1 && id < MAX_FILTERS) {
         selectedFilterComponent.updateFilterAndSliders(id);
         selectedFilterComponent.setVisible(true);
-        buttonArr[id]->repaint();
     }
     else {
         selectedFilterComponent.setVisible(false);
@@ -187,12 +255,61 @@ void SemiProQAudioProcessorEditor::analyserOnChanged() {
     bool isOn = analyserOnValue.getValue();
 
     analyserComponent.setVisible(isOn);
+    spectrogramOnChanged();
 }
 
 void SemiProQAudioProcessorEditor::analyserModeChanged() {
-    bool isPost = analyserModeValue.getValue();
-    auto color = isPost ? juce::Colours::lime : juce::Colours::yellow;
-    analyserComponent.lineColor = color;
+    //old sessions saved a bool, true is POST either way
+    int mode = analyserModeValue.getValue();
+    analyserComponent.setMode(mode);
+    settingsComponent.setAnalyserMode(mode);
+}
+
+void SemiProQAudioProcessorEditor::analyserChannelChanged() {
+    int channel = analyserChannelValue.getValue();
+    analyserComponent.setChannel(channel);
+    settingsComponent.setAnalyserChannel(channel);
+}
+
+void SemiProQAudioProcessorEditor::spectrogramOnChanged() {
+    bool isOn = spectrogramOnValue.getValue();
+    bool analyserOn = analyserOnValue.getValue();
+    //history from before it was hidden would have a gap in it
+    if (!(isOn && analyserOn)) {
+        spectrogramComponent.clear();
+    }
+    spectrogramComponent.setVisible(isOn && analyserOn);
+}
+
+void SemiProQAudioProcessorEditor::analyserAverageChanged() {
+    int average = analyserAverageValue.getValue();
+    analyserComponent.setAverage(average);
+    settingsComponent.setAnalyserAverage(average);
+}
+
+void SemiProQAudioProcessorEditor::analyserFillChanged() {
+    bool shouldFill = analyserFillValue.getValue();
+    analyserComponent.setFill(shouldFill);
+}
+
+void SemiProQAudioProcessorEditor::analyserSmoothingChanged() {
+    int smoothing = analyserSmoothingValue.getValue();
+    analyserComponent.setSmoothing(smoothing);
+    settingsComponent.setAnalyserSmoothing(smoothing);
+}
+
+void SemiProQAudioProcessorEditor::curveTracesChanged() {
+    int mode = curveTracesValue.getValue();
+    responseCurveComponent.setTraces(mode);
+    settingsComponent.setCurveTraces(mode);
+}
+
+//the layout never changes, the whole editor is transformed. views keep their sizes, so pixel maps, curve tables, and meter geometry
+//stay as they are, and only the image caches re-render once at the new physical scale
+void SemiProQAudioProcessorEditor::uiScaleChanged() {
+    int mode = juce::jlimit(0, UI_SCALE_AMT - 1, (int)uiScaleValue.getValue());
+    settingsComponent.setUiScale(mode);
+    AudioProcessorEditor::setScaleFactor(hostScale * UI_SCALES[mode]);
 }
 
 void SemiProQAudioProcessorEditor::peakOnChanged() {
@@ -207,30 +324,64 @@ void SemiProQAudioProcessorEditor::peakModeChanged() {
     bool isPost = peakModeValue.getValue();
     auto color = isPost ? juce::Colours::lime : juce::Colours::yellow;
     peakComponent.fillColor = color;
+    peakComponent.repaint();
 }
 
-//controls repaints of spec, peak, draggable buttons, and res curve
-void SemiProQAudioProcessorEditor::timerCallback() {
+//controls repaints of spec, peak, band nodes, and res curve
+void SemiProQAudioProcessorEditor::onVBlank() {
+    //vblanks come at the display's rate, the views' ballistics and holds are per TIMER_FPS step
+    const double now = juce::Time::getMillisecondCounterHiRes();
+    if (now - lastFrameMs < 1000.0 / TIMER_FPS - FRAME_SLACK_MS) {
+        return;
+    }
+    lastFrameMs = now;
+    //nothing to step where nobody can see it. an analyser whose frames stop getting picked up drops out of the worker on its own
+    if (!isOnScreen()) {
+        return;
+    }
+
+    //every view reports the area it changed in its own coords, nothing at all while it has no new data
+    frameDirty.clear();
+    auto addDirty = [this](const juce::Component& c, juce::Rectangle<int> area) {
+        if (!area.isEmpty()) {
+            frameDirty.add(area + c.getPosition());
+        }
+    };
     //only draw if curve is dirty
     if (audioProcessor.getCurveStatus()) {
-        responseCurveComponent.timerCallback();
         audioProcessor.setCurveStatus(false);
+        addDirty(responseCurveComponent, responseCurveComponent.frameCallback());
     }
-    //only repaint if true
-    for (auto& button : buttonArr) {
-        if (button->needsRepaint.load()) {
-            button->repaint();
-            button->needsRepaint.store(false);
-        }
-    }
-    //if on, redraw frame
+    //just the nodes that moved, lit, or changed selection
+    addDirty(nodeOverlay, nodeOverlay.frameCallback());
+    //if on, take the new frame, which also feeds the spectrogram
     if (analyserOnValue.getValue()) {
-        analyserComponent.timerCallback();
+        addDirty(analyserComponent, analyserComponent.frameCallback());
+        addDirty(spectrogramComponent, spectrogramComponent.frameCallback());
     }
-    //if on, redraw frame
+    //if on, step the meters
     if (peakOnValue.getValue()) {
-        peakComponent.timerCallback();
+        addDirty(peakComponent, peakComponent.frameCallback());
+    }
+    //curve, analyser, and spectrogram share bounds, so overlapping areas merge instead of being invalidated once per view
+    frameDirty.consolidate();
+    for (const auto& area : frameDirty) {
+        repaint(area);
+    }
+}
+
+//hidden, minimized, or on no display at all. a minimized host window doesn't always minimize the editor's own peer, but Windows parks it
+//and its children far off every display, so the screen bounds catch that. JUCE has no query for a window covered by others, so a
+//covered editor keeps stepping
+bool SemiProQAudioProcessorEditor::isOnScreen() const {
+    if (!isShowing()) {
+        return false;
+    }
+    auto* peer = getPeer();
+    if (peer == nullptr || peer->isMinimised()) {
+        return false;
     }
+    return juce::Desktop::getInstance().getDisplays().getRectangleList(false).intersectsRectangle(getScreenBounds());
 }
 
 //===============================================================================
@@ -248,11 +399,17 @@ void SemiProQAudioProcessorEditor::resizeVisualizers() {
     auto peakArea = getBounds().removeFromRight(METER_AREA_WIDTH + BORDER_SPACING);
     //uses area with the removed right section
     analyserComponent.setBounds(area);
+    spectrogramComponent.setBounds(area);
     responseCurveComponent.setBounds(area);
+    nodeOverlay.setBounds(area.expanded(DRAG_BUTTON_DIM / 2));
     //add the bottom back to it for the peak
     peakArea.setBottom(area.getBottom() + BORDER_SPACING);
     peakArea.setRight(peakArea.getRight() + BORDER_SPACING);
     peakComponent.setBounds(peakArea);
+    //meter ticks line up with the background's dB labels
+    auto ys = getDbLabelYs();
+    peakComponent.setYs(ys);
+    peakComponent.resized();
 }
 
 void SemiProQAudioProcessorEditor::referAndAddListener(juce::Value& val, int idx) {
@@ -260,20 +417,13 @@ void SemiProQAudioProcessorEditor::referAndAddListener(juce::Value& val, int idx
     val.addListener(this);
 }
 
-void SemiProQAudioProcessorEditor::setupDraggableButtons() {
-    //build button array and check if we are coming from load then set accordingly
+void SemiProQAudioProcessorEditor::setupBandNodes() {
+    //colour each node and check if we are coming from load then show accordingly
+    addAndMakeVisible(nodeOverlay);
     for (int i = 0; i < MAX_FILTERS; ++i) {
-        buttonArr.add(new DraggableButton(audioProcessor, *this, i, colours[i]));
-        addChildComponent(buttonArr[i]);
-    }
-    for (int i = 0; i < MAX_FILTERS; ++i) {
-        if (audioProcessor.tree.state[props[i]]) {
-            buttonArr[i]->updatePositionFromParams();
-            buttonArr[i]->setVisible(true);
-        }
-        else {
-            buttonArr[i]->setVisible(false);
-        }
+        nodeOverlay.setNodeColour(i, colours[i]);
+        responseCurveComponent.setBandColour(i, colours[i]);
+        nodeOverlay.setNodeActive(i, audioProcessor.tree.state[props[i]]);
     }
 }
 
@@ -284,17 +434,15 @@ void SemiProQAudioProcessorEditor::setupMinimizableComp(MinimizableComponent& c,
     c.applyMinimized(c, v.getValue());
 }
 
-void SemiProQAudioProcessorEditor::backgroundImage() {
+void SemiProQAudioProcessorEditor::paintBackground(juce::Graphics& g) {
     using namespace juce;
-    background = Image(Image::PixelFormat::RGB, getWidth(), getHeight(), true);
-    Graphics g(background);
+    g.fillAll(Colours::black);
     StringArray freqs{ "20", "30", "40", "50", "100", "200", "300", "400",
                        "500", "1K", "2K", "3K", "4K", "5K", "10K", "20K" };
     //PRECOMPUTED WITH logRange<float>
     Array<float> normX{ 0, 0.0586971, 0.100343, 0.132647, 0.23299, 0.333333, 0.39203, 0.433677,
                         0.46598, 0.566323, 0.666667, 0.725364, 0.76701, 0.799313, 0.899657, .999999 };
     Array<float> xs;
-    Array<float> ys;
     StringArray gain{ "-72", "-60", "-48", "-36","-24", "-12", " 0", "+12", "+24" };
     auto renderArea = getRenderArea();
     auto left = renderArea.getX();
@@ -315,10 +463,9 @@ void SemiProQAudioProcessorEditor::backgroundImage() {
         g.drawVerticalLine(x, top, bottom);
     }
 
-    //get y pixels from ys then draw line
+    //draw a line every 12 dB
     for (int i = MIN_DB; i < MAX_DB + 12; i += 12) {
         int y = jmap(i, (int)MIN_DB, (int)MAX_DB, bottom, top);
-        ys.add(y);
         g.setColour(i == 0.0f ? Colours::limegreen : Colours::darkgrey);
         g.drawHorizontalLine(y, left, right);
     }
@@ -332,14 +479,13 @@ void SemiProQAudioProcessorEditor::backgroundImage() {
         auto textWidth = g.getCurrentFont().getStringWidth(f);
         Rectangle<int> r;
         r.setSize(textWidth, BG_FONT_SIZE);
-        r.setCentre(x - 2, ys[8] - 7);
+        r.setCentre(x - 2, top - 7);
         g.drawFittedText(f, r, juce::Justification::centred, 1);
     }
 
     //write dB numbers
-    auto n = ys.size() - 1;
-    auto textWidth = g.getCurrentFont().getStringWidth(gain[n]);
-    ys.set(n, ys[n] + 4);
+    auto ys = getDbLabelYs();
+    auto textWidth = g.getCurrentFont().getStringWidth(gain[ys.size() - 1]);
     for (int i = 0; i < ys.size(); ++i) {
         Rectangle<int> r;
         r.setSize(textWidth, BG_FONT_SIZE);
@@ -352,9 +498,17 @@ void SemiProQAudioProcessorEditor::backgroundImage() {
     //rectangle around render area
     g.setColour(Colours::orange);
     g.drawRoundedRectangle(left, top, width, height, CORNER_SIZE, 1.0f);
+}
 
-    peakComponent.setYs(ys);
-    peakComponent.resized();
+juce::Array<float> SemiProQAudioProcessorEditor::getDbLabelYs() {
+    auto renderArea = getRenderArea();
+    juce::Array<float> ys;
+    for (int i = MIN_DB; i < MAX_DB + 12; i += 12) {
+        ys.add(juce::jmap(i, (int)MIN_DB, (int)MAX_DB, renderArea.getBottom(), renderArea.getY()));
+    }
+    //top label sits just inside the window
+    ys.set(ys.size() - 1, ys.getLast() + 4);
+    return ys;
 }
 
 void SemiProQAudioProcessorEditor::openHelpDialog() {
@@ -3,32 +3,48 @@
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
 #include "CustomLookAndFeel.h"
-#include "Components/Controls/DraggableButton.h"
+#include "Components/Controls/BandNodeOverlay.h"
 #include "Components/Controls/GainComponent.h"
 #include "Components/Controls/SelectedFilterComponent.h"
 #include "Components/Controls/SettingsComponent.h"
 #include "Components/Visualization/PeakMeterComponent.h"
 #include "Components/Visualization/ResponseCurveComponent.h"
+#include "Components/Visualization/SpectrogramComponent.h"
 #include "Components/Visualization/SpectrumAnalyserComponent.h"
 #include "Components/Dialogs/CreditsWindow.h"
 #include "Components/Dialogs/HelpWindow.h"
+#include "Utils/ChromeLayer.h"
 #include "Utils/Constants.h"
 
+//==============================================================================
+/** Editor background layers by physical scale. The layout is the same in every instance, so open editors share them through
+    juce::SharedResourcePointer and only the first one at a scale renders
+*/
+struct SharedBackground {
+    ChromeLayer& forScale(float scale) {
+        return layers[juce::roundToInt(scale * 1000.0f)];
+    }
+
+private:
+    std::map<int, ChromeLayer> layers;
+};
+
 //==============================================================================
 /**
 */
-class SemiProQAudioProcessorEditor : public juce::AudioProcessorEditor, juce::Value::Listener, juce::Timer {
+class SemiProQAudioProcessorEditor : public juce::AudioProcessorEditor, juce::Value::Listener {
 public:
     SemiProQAudioProcessorEditor(SemiProQAudioProcessor&);
     ~SemiProQAudioProcessorEditor() override;
 
     //resets button parameters after right clicking
     void buttonReset(int id);
-    //bounds of where the buttons can be dragged or double clicked
+    //bounds of where band nodes can be dragged or double clicked
     juce::Rectangle<int> buttonBounds;
     //public values that refer to properties in value tree
     juce::Value selectedFilterValue, minGain, minSettings, minSelected, 
-                analyserOnValue, analyserModeValue, analyserSlopeValue, peakOnValue, peakModeValue;
+                analyserOnValue, analyserModeValue, analyserChannelValue, spectrogramOnValue,
+                analyserAverageValue, analyserFillValue, analyserSmoothingValue, curveTracesValue, analyserSlopeValue, peakOnValue, peakModeValue, uiScaleValue;
 
     //called on selectedFilter change to get associated colour
     juce::Colour getColour(int i) {
@@ -37,22 +53,26 @@ public:
     //on settings button press, open these dialog boxes
     void openCreditsDialog();
     void openHelpDialog();
+    //host's display scale, kept so the ui scale mode can be applied on top of it
+    void setScaleFactor(float newScale) override;
 
 private:
     //construction helpers
-    void setupDraggableButtons();
+    void setupBandNodes();
     void setupMinimizableComp(MinimizableComponent& c, juce::Value& v);
     void resizeVisualizers();
     void referAndAddListener(juce::Value& val, int idx);
     //component update callbacks
     void paint(juce::Graphics&) override;
     void resized() override;
-    //double click to initialize a new draggable button
+    //double click to initialize a new band node
     void mouseDoubleClick(const juce::MouseEvent& event) override;
     //get area without border size
     juce::Rectangle<int> getRenderArea();
-    //draw and cache background image
-    void backgroundImage();
+    //grid, labels, and outline drawn into the cached background layer
+    void paintBackground(juce::Graphics& g);
+    //y of each 12 dB label from MIN_DB up, shared by the background and the peak meter's ticks
+    juce::Array<float> getDbLabelYs();
     //after deleted button, check which should be visible in selected filter component, if any
     void sfcVisiblityCheck();
     //property change callback from value tree
@@ -61,23 +81,35 @@ private:
     void selectedFilterChanged();
     void analyserOnChanged();
     void analyserModeChanged();
+    void analyserChannelChanged();
+    void spectrogramOnChanged();
+    void analyserAverageChanged();
+    void analyserFillChanged();
+    void analyserSmoothingChanged();
+    void curveTracesChanged();
+    void uiScaleChanged();
     void peakOnChanged();
     void peakModeChanged();
-    //timer to trigger children's repaints
-    void timerCallback() override;
+    //steps the views at TIMER_FPS off the display's vblank and repaints what they report as changed, merged into one region
+    void onVBlank();
+    //false while the editor is hidden, minimized, or off every display
+    bool isOnScreen() const;
 
-    CustomLookAndFeelA lnfa;
-    CustomLookAndFeelB lnfb;
-    CustomLookAndFeelC lnfc;
-    CustomLookAndFeelD lnfd;
-    CustomLookAndFeelE lnfe;
-    CustomLookAndFeelF lnff;
+    //made with the first open editor and freed with the last
+    juce::SharedResourcePointer<EditorLookAndFeels> lookAndFeels;
+    CustomLookAndFeelA& lnfa = lookAndFeels->a;
+    CustomLookAndFeelB& lnfb = lookAndFeels->b;
+    CustomLookAndFeelC& lnfc = lookAndFeels->c;
+    CustomLookAndFeelD& lnfd = lookAndFeels->d;
+    CustomLookAndFeelE& lnfe = lookAndFeels->e;
+    CustomLookAndFeelF& lnff = lookAndFeels->f;
 
     SemiProQAudioProcessor& audioProcessor;
     PeakMeterComponent peakComponent;
+    SpectrogramComponent spectrogramComponent;
     SpectrumAnalyserComponent analyserComponent;
     ResponseCurveComponent responseCurveComponent;
-    juce::OwnedArray<DraggableButton> buttonArr;
+    BandNodeOverlay nodeOverlay;
     SelectedFilterComponent selectedFilterComponent;
     GainComponent gainComponent;
     SettingsComponent settingsComponent;
@@ -85,13 +117,23 @@ private:
     std::unique_ptr<HelpWindow> helpWindow;
     std::unique_ptr<CreditsWindow> creditsWindow;
 
-    juce::Image background;
+    //vector rendered once per physical scale, so every ui scale mode gets a sharp 1:1 blit. a first open paints without it and
+    //renders it on a repaint posted right after (still on the message thread), so the first frame isn't held up
+    juce::SharedResourcePointer<SharedBackground> background;
+    bool backgroundDue = false, firstPainted = false;
+    float hostScale = 1.0f;
     juce::TooltipWindow tooltipWindow{ this, TOOLTIP_DELAY_MS };
+    //time of the last view step, and the area every view changed in it
+    double lastFrameMs = 0.0;
+    juce::RectangleList<int> frameDirty;
 
-    //Draggable button & selected eq color array
+    //band node & selected eq color array
     const juce::Array<juce::Colour> colours{ juce::Colours::red, juce::Colours::darkorange, juce::Colours::yellow, juce::Colours::green,
                                              juce::Colours::blue, juce::Colours::indigo, juce::Colours::violet, juce::Colours::darkgoldenrod,
                                              juce::Colours::pink, juce::Colours::olive, juce::Colours::beige, juce::Colours::crimson };
 
+    //declared last so it's gone before anything it steps
+    juce::VBlankAttachment vblank;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SemiProQAudioProcessorEditor)
 };
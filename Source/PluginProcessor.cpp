@@ -5,7 +5,12 @@
 //==============================================================================
 SemiProQAudioProcessor::SemiProQAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
-    : AudioProcessor(BusesProperties().withInput("Input", juce::AudioChannelSet::stereo(), true).withOutput("Output", juce::AudioChannelSet::stereo(), true))
+    : AudioProcessor(BusesProperties().withInput("Input", juce::AudioChannelSet::stereo(), true).withOutput("Output", juce::AudioChannelSet::stereo(), true)
+                     //crossover band outputs, off until the host enables them
+                     .withOutput("Band 1", juce::AudioChannelSet::stereo(), false)
+                     .withOutput("Band 2", juce::AudioChannelSet::stereo(), false)
+                     .withOutput("Band 3", juce::AudioChannelSet::stereo(), false)
+                     .withOutput("Band 4", juce::AudioChannelSet::stereo(), false))
 #endif 
 {
     //cache sample rate
@@ -31,16 +36,26 @@ SemiProQAudioProcessor::SemiProQAudioProcessor()
         //initialize filter vectors with coefficients from info
         filters[i].update(info, lastSampleRate);
     }
+    crossover.update(filterData, lastSampleRate);
+    //analyser fifo lives as long as the processor, the analysis worker may be reading it at any time
+    analyserFifo = std::make_unique<Fifo<float>>(FFT_RING_SIZE * ANALYSER_TAPS);
 
-    //analyserOn, analyserMode, minimizeGain, minimizeSelectedEq, minimizeConfigs, peakOn, peakMode, and selectedEq properties
+    //analyserOn, analyserMode, minimizeGain, minimizeSelectedEq, minimizeConfigs, peakOn, peakMode, selectedEq, analyserChannel, spectrogramOn, analyserAverage, analyserFill, analyserSmoothing, and curveTraces properties
     initProperty(ANALYSER_ON, true);
-    initProperty(ANALYSER_MODE, true); //TRUE IS POST
+    initProperty(ANALYSER_MODE, ANALYSER_POST); //PRE, POST, BOTH, DELTA. old sessions saved a bool, TRUE IS POST
     initProperty(PEAK_ON, true);
     initProperty(PEAK_MODE, true);     //TRUE IS POST 
     initProperty(MINIMIZE_GAIN, false);
     initProperty(MINIMIZE_SELECTED, false);
     initProperty(MINIMIZE_SETTINGS, false);
     initProperty(SELECTED_FILTER, -1);
+    initProperty(ANALYSER_CHANNEL, ANALYSER_MID);
+    initProperty(SPECTROGRAM_ON, false);
+    initProperty(ANALYSER_AVERAGE, ANALYSER_AVG_OFF);
+    initProperty(ANALYSER_FILL, false);
+    initProperty(ANALYSER_SMOOTHING, ANALYSER_SMOOTH_OFF);
+    initProperty(CURVE_TRACES, CURVE_TRACES_OFF);
+    initProperty(UI_SCALE, UI_SCALE_LARGE);
 }
 
 SemiProQAudioProcessor::~SemiProQAudioProcessor() {
@@ -107,11 +122,14 @@ void SemiProQAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBloc
     lastSampleRate = sampleRate;
     spec.sampleRate = sampleRate;
     spec.maximumBlockSize = samplesPerBlock;
-    spec.numChannels = getTotalNumOutputChannels();
+    //only the main bus runs through the eq, aux buses are crossover outputs
+    spec.numChannels = getMainBusNumOutputChannels();
 
     for (auto& filter : filters) {
         filter.prepare(spec);
     }
+    crossover.prepare(spec);
+    crossover.update(filterData, sampleRate);
 
     preGain.setRampDurationSeconds(GAIN_RAMP_TIME);
     preGain.prepare(spec);
@@ -121,48 +139,61 @@ void SemiProQAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBloc
     postGain.prepare(spec);
     postGain.setGainDecibels(*tree.getRawParameterValue(params[POSTGAIN]));
     
-    analyserFifo = std::make_unique<Fifo<float>>(FFT_SIZE + FFT_HOP_SIZE);
-    if (analyserFifo) {
-        analyserFifo->clear();
-    }
+    analyserFifo->clear();
 }
 
-void SemiProQAudioProcessor::releaseResources() {
-    analyserFifo.reset();
-}
+void SemiProQAudioProcessor::releaseResources() {}
 
-//if there's a need for a standalone, remove preset channel cofigs and uncomment this
-//bool SemiProQAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const {
-//    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-//        && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo()) {
-//        return false;
-//    }
-//    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet()) {
-//        return false;
-//    }
-//    return true;
-//}
+//main bus is mono or stereo in and out, crossover band buses are either off or match the main output
+bool SemiProQAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const {
+    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
+        && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo()) {
+        return false;
+    }
+    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet()) {
+        return false;
+    }
+    for (int i = 1; i < layouts.outputBuses.size(); ++i) {
+        const auto& set = layouts.getChannelSet(false, i);
+        if (!set.isDisabled() && set != layouts.getMainOutputChannelSet()) {
+            return false;
+        }
+    }
+    return true;
+}
 
 void SemiProQAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
-    //get channels and numSamples
+    //get main bus channels and numSamples. aux band buses sit after the main channels, so a mono main bus never reads one as right
     juce::ScopedNoDenormals noDenormals;
-    auto* left = buffer.getReadPointer(0);
-    auto* right = buffer.getNumChannels() > 1 ? buffer.getReadPointer(1) : nullptr;
+    auto mainBuffer = getBusBuffer(buffer, false, 0);
+    auto* left = mainBuffer.getReadPointer(0);
+    auto* right = mainBuffer.getNumChannels() > 1 ? mainBuffer.getReadPointer(1) : nullptr;
     const int numSamples = buffer.getNumSamples();
     //analyser & peak bools from properties
     const bool analyserOn = analyserFifo && tree.state[props[ANALYSER_ON]];
-    const bool analyserMode = tree.state[props[ANALYSER_MODE]];
+    const int analyserChannel = tree.state[props[ANALYSER_CHANNEL]];
+    //L+R puts left and right of one tap in the ring instead of pre and post of one channel
+    const bool analyserOverlay = analyserChannel == ANALYSER_LR;
+    const bool analyserOverlayPre = analyserOverlay && (int)tree.state[props[ANALYSER_MODE]] == ANALYSER_PRE;
     const bool peakOn = tree.state[props[PEAK_ON]];
     const bool peakMode = tree.state[props[PEAK_MODE]];
+    //analyser taps pre and post every block whatever the mode, so switching pre/post modes never has to realign the ring. both are mixed
+    //straight into the ring's frames, pre now and post after the eq, and handed over together. the whole block goes in whatever the host's
+    //block size, only a full ring drops frames
     //use property bools to get analysis state bools
-    const bool analyserPre = analyserOn && !analyserMode;
-    const bool analyserPost = analyserOn && analyserMode;
     const bool peakPre = peakOn && !peakMode;
     const bool peakPost = peakOn && peakMode;
 
     //pre eq spectrum analysis and peak readings
-    if (analyserPre) {
-        analyserFifo->getBufferSamples(left, right, numSamples);
+    if (analyserOn) {
+        analyserFifo->beginFrames(numSamples);
+    }
+    if (analyserOn && !analyserOverlay) {
+        analyserFifo->writeTap(0, left, right, analyserChannel);
+    }
+    if (analyserOn && analyserOverlayPre) {
+        analyserFifo->writeTap(0, left, right, ANALYSER_LEFT);
+        analyserFifo->writeTap(1, left, right, ANALYSER_RIGHT);
     }
     if (peakPre) {
         leftPeak.getPeakFromBlock(left, numSamples);
@@ -174,8 +205,8 @@ void SemiProQAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
     //update dirty filters
     updateFilters();
 
-    //prepare block
-    juce::dsp::AudioBlock<float> block(buffer);
+    //prepare block, main bus only
+    juce::dsp::AudioBlock<float> block(mainBuffer);
     juce::dsp::ProcessContextReplacing<float> context(block);
     //process pre gain
     preGain.process(context);
@@ -186,9 +217,36 @@ void SemiProQAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
     //process post gain
     postGain.process(context);
 
+    //split the eq'd signal into crossover bands, clear any enabled band bus that has no band. with every band bus off nothing reads the
+    //bands, so the split tree doesn't run at all
+    bool anyBandBus = false;
+    for (int b = 0; b < MAX_CROSSOVER_BANDS; ++b) {
+        anyBandBus = anyBandBus || getChannelCountOfBus(false, b + 1) > 0;
+    }
+    const int numBands = anyBandBus ? crossover.process(mainBuffer) : 0;
+    for (int b = 0; anyBandBus && b < MAX_CROSSOVER_BANDS; ++b) {
+        auto bandBuffer = getBusBuffer(buffer, false, b + 1);
+        if (bandBuffer.getNumChannels() == 0) {
+            continue;
+        }
+        if (b < numBands) {
+            crossover.copyBand(b, bandBuffer);
+        }
+        else {
+            bandBuffer.clear();
+        }
+    }
+
     //post eq spectrum analysis and peak readings
-    if (analyserPost) {
-        analyserFifo->getBufferSamples(left, right, numSamples);
+    if (analyserOn && !analyserOverlay) {
+        analyserFifo->writeTap(1, left, right, analyserChannel);
+    }
+    if (analyserOn && analyserOverlay && !analyserOverlayPre) {
+        analyserFifo->writeTap(0, left, right, ANALYSER_LEFT);
+        analyserFifo->writeTap(1, left, right, ANALYSER_RIGHT);
+    }
+    if (analyserOn) {
+        analyserFifo->finishFrames();
     }
     if (peakPost) {
         leftPeak.getPeakFromBlock(left, numSamples);
@@ -267,7 +325,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout SemiProQAudioProcessor::crea
                 return text.getFloatValue();
                 })
         ));
-        //init type(0 is peak, 1 is low cut(b_worth), 2 is high cut(b_worth), 3 is low cut(resonant), 4 is high cut(resonant), 5 is high shelf, 6 is low shelf, 7 is notch)
+        //init type(0 is peak, 1 is low cut(b_worth), 2 is high cut(b_worth), 3 is low cut(resonant), 4 is high cut(resonant), 5 is high shelf, 6 is low shelf, 7 is notch, 8 is crossover split)
         layout.add(std::make_unique<juce::AudioParameterChoice>(params[TYPE + i * PARAMS_PER_FILTER], params[TYPE + i * PARAMS_PER_FILTER], filterTypes, 0));
         //init butterworth int for stages if filter is in a butterworth mode
         layout.add(std::make_unique<juce::AudioParameterChoice>(params[B_WORTH + i * PARAMS_PER_FILTER], params[B_WORTH + i * PARAMS_PER_FILTER], b_worths, 0));
@@ -291,7 +349,7 @@ void SemiProQAudioProcessor::updateParameter(int eqInd, int paramInd, float newV
     }
 }
 
-//update req struct and gui coeffs, b_worth doesn't require coeffs changes, so it returns right away
+//update req struct and gui coeffs. b_worth only needs new coeffs on dB/oct types, since each stage's Q depends on the order
 void SemiProQAudioProcessor::parameterChanged(const juce::String& paramID, float newValue) {
     int filterIndex = -1;
     int digitEnd = 0;
@@ -331,10 +389,10 @@ void SemiProQAudioProcessor::updateFilterStruct(FilterInfo& info, juce::String p
             info.dirty.store(true);
         }
     }
-    //q doesn't affect dB/oct filters
+    //q doesn't affect dB/oct filters or crossover splits
     else if (paramName == "Quality") {
         info.quality.store(newValue);
-        if (!(info.type == HIGHPASS_OCT || info.type == LOWPASS_OCT)) {
+        if (!isSlopeType(info.type)) {
             info.dirty.store(true);
         }
     }
@@ -343,10 +401,10 @@ void SemiProQAudioProcessor::updateFilterStruct(FilterInfo& info, juce::String p
         info.type.store(static_cast<int>(newValue));
         info.dirty.store(true);
     }
-    //never needs coeff update, but still needs a responseCurveRepaint msg
+    //dB/oct types rebuild every stage, the per stage Q changes with the order. other types ignore it
     else if (paramName == "dB/Oct") {
         info.b_worth.store(static_cast<int>(newValue));
-        if (info.type == HIGHPASS_OCT || info.type == LOWPASS_OCT) {
+        if (isSlopeType(info.type)) {
             info.dirty.store(true);
         }
     }
@@ -389,11 +447,17 @@ void SemiProQAudioProcessor::resetEq(int ind) {
 //helper for process block to use filterInfo to decide on which filters are updated
 void SemiProQAudioProcessor::updateFilters() {
     const double sr = lastSampleRate;
+    bool anyDirty = false;
     for (int i = 0; i < MAX_FILTERS; ++i) {
         auto& info = filterData[i];
         if (info.dirty.load()) {
             filters[i].update(info, sr);
             dirtyCurve.store(true);
+            anyDirty = true;
         }
     }
+    //any band can become or stop being a split point, so the crossover rechecks on every change
+    if (anyDirty) {
+        crossover.update(filterData, sr);
+    }
 }
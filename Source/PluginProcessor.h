@@ -73,8 +73,8 @@ public:
     const bool getCurveStatus() const { return dirtyCurve.load(); }
     void setCurveStatus(bool b) { dirtyCurve.store(b); }
     
-    //thread safe read to get target val
-    void getCoeffs(int i, float* dest) { filters[i].readCoeffs(dest); }
+    //thread safe read to get target val of one filter stage
+    void getCoeffs(int i, float* dest, int stage = 0) { filters[i].readCoeffs(dest, stage); }
 
     //peak metering objects to measure each channel
     PeakMeasurement leftPeak;
@@ -102,9 +102,11 @@ private:
     std::array<SmoothFilter, MAX_FILTERS> filters;
     //faster and safer than grabbing from ValueTree
     std::array<FilterInfo, MAX_FILTERS> filterData;
+    //splits the eq'd signal to the band buses using X-OVER bands
+    Crossover crossover;
     //spec to prepare dsp objects
     juce::dsp::ProcessSpec spec;
-    //ptr for analyser fifo. needs reset on release resources
+    //ptr for analyser fifo. made once in the constructor and only cleared after, never freed under the worker
     std::unique_ptr<Fifo<float>> analyserFifo;
     //gain dsp object with internal smoothedValues
     juce::dsp::Gain<float> preGain, postGain;
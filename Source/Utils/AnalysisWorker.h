@@ -0,0 +1,74 @@
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Utils/Constants.h"
+
+//==============================================================================
+/** Process wide analysis worker: every open editor's analyser registers here instead of doing its FFT on the message thread.
+*/
+//anything that builds frames on the worker. runAnalysis() is only ever called on the worker thread, wantsFrames is set by the message thread
+struct AnalysisClient {
+    virtual ~AnalysisClient() = default;
+    //pull new samples and build a frame if there is one
+    virtual void runAnalysis() = 0;
+    //hidden or switched off clients are skipped, so they cost nothing but a flag check
+    std::atomic<bool> wantsFrames{ false };
+    //stamped by the message thread on every pickup. nobody is looking at a client whose frames stop getting picked up, so it's skipped too
+    std::atomic<juce::uint32> lastPickupMs{ 0 };
+    bool isIdle(juce::uint32 nowMs) const {
+        return nowMs - lastPickupMs.load() > ANALYSER_IDLE_MS;
+    }
+};
+
+//One thread shared by every plugin instance in the process through juce::SharedResourcePointer, started by the first analyser and stopped
+//with the last one. Each pass runs every client that wants frames once, starting one client later each pass so no instance is always last.
+//Clients are run under clientLock, so removeClient() blocks until the client's current job is done and it's safe to destroy afterwards
+struct AnalysisWorker : juce::Thread {
+    AnalysisWorker() : juce::Thread("SemiProQ Analysis") {
+        startThread(juce::Thread::Priority::low);
+    }
+
+    ~AnalysisWorker() override {
+        stopThread(1000);
+    }
+
+    void addClient(AnalysisClient* c) {
+        const juce::ScopedLock sl(clientLock);
+        clients.addIfNotAlreadyThere(c);
+    }
+
+    void removeClient(AnalysisClient* c) {
+        const juce::ScopedLock sl(clientLock);
+        clients.removeFirstMatchingValue(c);
+    }
+
+private:
+    void run() override {
+        const double framePeriodMs = 1000.0 / TIMER_FPS;
+        while (!threadShouldExit()) {
+            const auto start = juce::Time::getMillisecondCounterHiRes();
+            const auto nowMs = juce::Time::getMillisecondCounter();
+            {
+                const juce::ScopedLock sl(clientLock);
+                const int n = clients.size();
+                for (int i = 0; i < n && !threadShouldExit(); ++i) {
+                    auto* c = clients.getUnchecked((nextClient + i) % n);
+                    if (c->wantsFrames.load() && !c->isIdle(nowMs)) {
+                        c->runAnalysis();
+                    }
+                }
+                nextClient = n > 0 ? (nextClient + 1) % n : 0;
+            }
+            //sleep out the rest of the frame, always give up at least a ms
+            const auto elapsed = juce::Time::getMillisecondCounterHiRes() - start;
+            wait(juce::jmax(1, (int)(framePeriodMs - elapsed)));
+        }
+    }
+
+    juce::CriticalSection clientLock;
+    juce::Array<AnalysisClient*> clients;
+    int nextClient = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalysisWorker)
+};
@@ -18,6 +18,42 @@ struct FilterInfo {
     std::atomic<bool> bypass{ true };
     std::atomic<bool> dirty{ false };
 };
+
+//dB/oct helpers: b_worth choices repeat MAX_STAGES slopes, first for Butterworth, then for Linkwitz-Riley. Each slope step is one biquad
+inline int getCascadeStages(int bWorth) {
+    return juce::jlimit(1, MAX_STAGES, bWorth % MAX_STAGES + 1);
+}
+
+inline bool isLinkwitzRiley(int bWorth) {
+    return bWorth >= MAX_STAGES;
+}
+
+//types that use b_worth for their slope instead of quality
+inline bool isSlopeType(int type) {
+    return type == HIGHPASS_OCT || type == LOWPASS_OCT || type == CROSSOVER;
+}
+
+//Q of one pole pair of an analog Butterworth. Even orders have no real pole, odd orders have one on the real axis between the pairs
+inline float getButterworthPairQ(int order, int pair) {
+    const double pi = juce::MathConstants<double>::pi;
+    const double angle = (order % 2 == 0) ? (2 * pair + 1) * pi / (2.0 * order) : (pair + 1) * pi / order;
+    return static_cast<float>(1.0 / (2.0 * std::cos(angle)));
+}
+
+//Q of one biquad section in a dB/oct cascade. Butterworth of order 2N is N pole pairs, one per section.
+//Linkwitz-Riley is a Butterworth of order N squared, so each pole pair shows up twice and an odd N adds a Q = 0.5 section for the two real poles
+inline float getCascadeQ(int bWorth, int stage) {
+    const int stageAmt = getCascadeStages(bWorth);
+    if (!isLinkwitzRiley(bWorth)) {
+        return getButterworthPairQ(stageAmt * 2, stage);
+    }
+    const int pair = stage / 2;
+    if (pair >= stageAmt / 2) {
+        return 0.5f;
+    }
+    return getButterworthPairQ(stageAmt, pair);
+}
+
 /*
 This is the combined logic of JUCE Coefficient, Filter, and ProcessorDuplicator classes, but with no allocation after construction, smooth coefficient transitions, 
 8 filter types, internal bypass logic, internal thread safe reads for the GUI & writes from the audio thread, while being smaller, faster, and contiguous.
@@ -29,8 +65,6 @@ The below only applies if you are not using this as a part of the Filter
 WARNINGS: COEFF FACTORIES MUST BE CALLED FROM AUDIO THREAD! readCoeffs() MAY BUSY READ! prepare() RESETS STATE AND HARD-SETS SMOOTHED VALUES DIRECTLY TO TARGETS!
 */
 struct EqStage {
-    //needed for the compilers that don't always precompute
-    static constexpr float inverseRootTwo = 0.70710678118654752440L;
     //same used in juce internal
     static constexpr float minimumDecibels = -300.0f;
     //==============================================================================
@@ -48,15 +82,7 @@ struct EqStage {
 
         factorAndWrite(1 + alphaTimesA, c2, 1 - alphaTimesA, 1 + alphaOverA, c2, 1 - alphaOverA);
     }
-    //LOWPASS_OCT
-    void makeLowPass(double sampleRate, float frequency) {
-        makeLowPass(sampleRate, frequency, inverseRootTwo);
-    }
-    //HIGHPASS_OCT
-    void makeHighPass(double sampleRate, float frequency) {
-        makeHighPass(sampleRate, frequency, inverseRootTwo);
-    }
-    //LOWPASS_Q
+    //LOWPASS_Q, and each LOWPASS_OCT stage with its Q from getCascadeQ()
     void makeLowPass(double sampleRate, float frequency, float Q) {
         const auto n = 1 / std::tan(juce::MathConstants<float>::pi * frequency / static_cast<float> (sampleRate));
         const auto nSquared = n * n;
@@ -65,7 +91,7 @@ struct EqStage {
 
         writeCoeffs(c1, c1 * 2, c1, c1 * 2 * (1 - nSquared), c1 * (1 - invQ * n + nSquared));
     }
-    //HIGHPASS_Q
+    //HIGHPASS_Q, and each HIGHPASS_OCT stage with its Q from getCascadeQ()
     void makeHighPass(double sampleRate, float frequency, float Q) {
         const auto n = std::tan(juce::MathConstants<float>::pi * frequency / static_cast<float> (sampleRate));
         const auto nSquared = n * n;
@@ -119,6 +145,24 @@ struct EqStage {
 
         writeCoeffs(b0, b1, b0, b1, c1 * (1 - n * invQ + nSquared));
     }
+    //ALLPASS: one pole pair of a Butterworth, numerator is the mirrored denominator. Used for crossover phase alignment
+    void makeAllPass(double sampleRate, float frequency, float Q) {
+        const auto n = 1 / std::tan(juce::MathConstants<float>::pi * frequency / static_cast<float> (sampleRate));
+        const auto nSquared = n * n;
+        const auto invQ = 1 / Q;
+        const auto c1 = 1 / (1 + invQ * n + nSquared);
+        const auto a1 = c1 * 2 * (1 - nSquared);
+        const auto a2 = c1 * (1 - invQ * n + nSquared);
+
+        writeCoeffs(a2, a1, 1.0f, a1, a2);
+    }
+    //ALLPASS: first order, the real pole of an odd order Butterworth
+    void makeAllPass(double sampleRate, float frequency) {
+        const auto n = 1 / std::tan(juce::MathConstants<float>::pi * frequency / static_cast<float> (sampleRate));
+        const auto c = (1 - n) / (1 + n);
+
+        writeCoeffs(c, 1.0f, 0.0f, c, 0.0f);
+    }
     //BYPASS: Set to lerp to identity coeff, set isBypassed, and set armedForReset
     void makeBypassed() {
         writeCoeffs(1.0f, 0.0f, 0.0f, 0.0f, 0.0f);
@@ -182,6 +226,39 @@ struct EqStage {
         }
     }
 
+    //==============================================================================
+    //CASCADE ACCESS
+    //only called from the audio thread by SmoothFilter when it runs the cascade kernel
+    //steady means done smoothing and not bypassed, the only state a stage can be handed to the kernel in
+    bool isSteady() const {
+        return !isSmoothing() && !isBypassed.load();
+    }
+    //full is smoothing check for coeffs
+    bool isSmoothing() const {
+        for (auto& val : coefficients) {
+            if (val.isSmoothing()) {
+                return true;
+            }
+        }
+        return false;
+    }
+    //target coeff in b0, b1, b2, a1, a2 order. GUI must use readCoeffs()
+    float getTargetCoeff(int i) const {
+        return coefficients[i].getTargetValue();
+    }
+    //two state vars per channel
+    float* getState(int channel) {
+        return state.data() + channel * 2;
+    }
+    //==============================================================================
+    //STATE RESET
+    //resets state floats to 0.0f
+    void reset() {
+        for (size_t i = 0; i < 4; ++i) {
+            state[i] = 0.0f;
+        }
+    }
+
 private:
     //==============================================================================
     //WRITE HELPERS
@@ -357,15 +434,6 @@ private:
     }
     //==============================================================================
     //SMOOTHED VALUE HELPERS
-    //full is smoothing check for coeffs
-    bool isSmoothing() {
-        for (auto& val : coefficients) {
-            if (val.isSmoothing()) {
-                return true;
-            }
-        }
-        return false;
-    }
     //reset lerp timing on sample rate change
     void resetCoeffs(double sampleRate) {
         for (auto& val : coefficients) {
@@ -380,14 +448,6 @@ private:
         }
     }
     //==============================================================================
-    //STATE RESET
-    //resets state floats to 0.0f
-    void reset() {
-        for (size_t i = 0; i < 4; ++i) {
-            state[i] = 0.0f;
-        }
-    }
-    //==============================================================================
     //MEMBER VARS
     //lerped coeffs
     std::array<juce::LinearSmoothedValue<float>, COEFF_SIZE> coefficients;
@@ -408,6 +468,10 @@ prepare() should only be called in prepareToPlay() and prepares all stages' filt
 process() should only be called in processBlock() and processes for all filter stages. Bypass, channels, and smoothing are all handled internally
 readCoeffs() should never be called from audio thread. It may busy read
 update() should only be called from audio thread. It will write to each stage's coeffs
+
+When 2+ leading stages are steady (dB/oct cascades) and the rest are done smoothing, process() runs the steady ones through a pipelined kernel:
+lane k runs stage k one sample behind lane k - 1, so every lane works on an independent sample each step and the lane loop vectorizes.
+Fill and drain steps are masked, so output and state are sample exact with the per stage path and no latency is added.
 */
 struct SmoothFilter {
     void prepare(const juce::dsp::ProcessSpec& spec) {
@@ -416,12 +480,41 @@ struct SmoothFilter {
         }
     }
     void process(const juce::dsp::ProcessContextReplacing<float>& context) {
-        for (auto& s : stages) {
-            s.process(context);
+        //count leading steady stages, the kernel can only take them if nothing after them is still smoothing
+        int steadyAmt = 0;
+        while (steadyAmt < MAX_STAGES && stages[steadyAmt].isSteady()) {
+            ++steadyAmt;
+        }
+        bool restSettled = true;
+        for (int j = steadyAmt; j < MAX_STAGES; ++j) {
+            restSettled = restSettled && !stages[j].isSmoothing();
+        }
+        //single stage filters and any smoothing go through each stage's own smoothing and bypass paths
+        if (steadyAmt < 2 || !restSettled) {
+            for (auto& s : stages) {
+                s.process(context);
+            }
+            return;
+        }
+        auto&& block = context.getOutputBlock();
+        const auto numSamples = block.getNumSamples();
+        const auto numChannels = juce::jmin((int)block.getNumChannels(), 2);
+        for (int ch = 0; ch < numChannels; ++ch) {
+            if (steadyAmt <= 4) {
+                processCascade<4>(block.getChannelPointer(ch), numSamples, ch, steadyAmt);
+            }
+            else {
+                processCascade<MAX_STAGES>(block.getChannelPointer(ch), numSamples, ch, steadyAmt);
+            }
+        }
+        //remaining stages are bypassed, this only lets them reset their state
+        for (int j = steadyAmt; j < MAX_STAGES; ++j) {
+            stages[j].process(context);
         }
     }
-    void readCoeffs(float* dest) {
-        stages[0].readCoeffs(dest);
+    //reads one stage's target coeffs, dB/oct filters need all of their stages
+    void readCoeffs(float* dest, int stage = 0) {
+        stages[stage].readCoeffs(dest);
     }
     void update(FilterInfo& info, double sr) {
         const auto bypass = info.bypass.load();
@@ -429,14 +522,15 @@ struct SmoothFilter {
         const auto q = info.quality.load();
         const auto gain = juce::Decibels::decibelsToGain(float(info.gain.load()), NEG_INF_DB);
         const auto type = info.type.load();
-        const int stageAmt = juce::jlimit(1, MAX_STAGES, info.b_worth.load() + 1);
+        const auto bWorth = info.b_worth.load();
+        const int stageAmt = getCascadeStages(bWorth);
         //if bypassed, set all filters to bypass for smoothing to bypass state
         if (bypass) {
             for (auto& s : stages) {
                 s.makeBypassed();
             }
         }
-        //else make filter coeffs of type. If type is butterworth, make b_worth amount of filters, else make them bypassed. 
+        //else make filter coeffs of type. If type is dB/oct, make b_worth amount of filters with their cascade Q, else make them bypassed. 
         //For all non b_worth filters, just make the first filter coeffs and make all the rest bypassed to smooth away the changes
         //all bypassing, smoothing, and processing is handled internally by the stage, this just sets the targets of the smoothed coefficients.
         else {
@@ -450,7 +544,7 @@ struct SmoothFilter {
                 }
                 case HIGHPASS_OCT: {
                     for (int j = 0; j < stageAmt; ++j) {
-                        stages[j].makeHighPass(sr, freq);
+                        stages[j].makeHighPass(sr, freq, getCascadeQ(bWorth, j));
                     }
                     for (int j = stageAmt; j < MAX_STAGES; ++j) {
                         stages[j].makeBypassed();
@@ -459,7 +553,7 @@ struct SmoothFilter {
                 }
                 case LOWPASS_OCT: {
                     for (int j = 0; j < stageAmt; ++j) {
-                        stages[j].makeLowPass(sr, freq);
+                        stages[j].makeLowPass(sr, freq, getCascadeQ(bWorth, j));
                     }
                     for (int j = stageAmt; j < MAX_STAGES; ++j) {
                         stages[j].makeBypassed();
@@ -501,6 +595,13 @@ struct SmoothFilter {
                     }
                     break;
                 }
+                //split points only feed the Crossover, they pass the main signal through untouched
+                case CROSSOVER: {
+                    for (auto& s : stages) {
+                        s.makeBypassed();
+                    }
+                    break;
+                }
                 default: {
                     break;
                 }
@@ -508,7 +609,231 @@ struct SmoothFilter {
         }
         info.dirty.store(false);
     }
+    //crossover halves are always Linkwitz-Riley at the chosen slope, whichever half of b_worths the choice is in
+    void makeCrossoverHalf(double sr, float freq, int bWorth, bool isHigh) {
+        const int lrChoice = bWorth % MAX_STAGES + MAX_STAGES;
+        const int stageAmt = getCascadeStages(lrChoice);
+        for (int j = 0; j < stageAmt; ++j) {
+            isHigh ? stages[j].makeHighPass(sr, freq, getCascadeQ(lrChoice, j)) : stages[j].makeLowPass(sr, freq, getCascadeQ(lrChoice, j));
+        }
+        for (int j = stageAmt; j < MAX_STAGES; ++j) {
+            stages[j].makeBypassed();
+        }
+    }
+    //allpass matching the phase of a crossover's low + high sum (high inverted on odd stage counts). That sum is B(-s) / B(s) of the
+    //Butterworth the Linkwitz-Riley was squared from, so it only takes that Butterworth's pole pairs plus a first order section when odd
+    void makeCrossoverAllPass(double sr, float freq, int bWorth) {
+        const int order = getCascadeStages(bWorth);
+        int j = 0;
+        for (; j < order / 2; ++j) {
+            stages[j].makeAllPass(sr, freq, getButterworthPairQ(order, j));
+        }
+        if (order % 2 == 1) {
+            stages[j++].makeAllPass(sr, freq);
+        }
+        for (; j < MAX_STAGES; ++j) {
+            stages[j].makeBypassed();
+        }
+    }
+    //clears all stage states, used when the crossover tree is rebuilt and old states belong to another split
+    void reset() {
+        for (auto& s : stages) {
+            s.reset();
+        }
+    }
 
 private:
+    //==============================================================================
+    //CASCADE KERNEL
+    //one pipeline step across all lanes. Masked steps only keep state for lanes holding a real sample (0 <= t - k < numSamples)
+    template <int lanes, bool masked>
+    static inline void cascadeStep(const float* b0, const float* b1, const float* b2, const float* a1, const float* a2,
+                                   float* s1, float* s2, const float* in, float* out, int t, int numSamples) noexcept {
+        for (int k = 0; k < lanes; ++k) {
+            const auto output = (in[k] * b0[k]) + s1[k];
+            const auto next1 = (in[k] * b1[k]) - (output * a1[k]) + s2[k];
+            const auto next2 = (in[k] * b2[k]) - (output * a2[k]);
+            if (masked) {
+                const bool valid = t - k >= 0 && t - k < numSamples;
+                s1[k] = valid ? next1 : s1[k];
+                s2[k] = valid ? next2 : s2[k];
+            }
+            else {
+                s1[k] = next1;
+                s2[k] = next2;
+            }
+            out[k] = output;
+        }
+    }
+    //runs the first stageAmt stages over one channel in place. Lanes past stageAmt are identity biquads, so lane width is fixed per template
+    template <int lanes>
+    void processCascade(float* data, size_t numSamples, int channel, int stageAmt) noexcept {
+        static_assert(lanes <= MAX_STAGES, "cascade lanes can't exceed the stage count");
+        alignas(32) float b0[lanes], b1[lanes], b2[lanes], a1[lanes], a2[lanes];
+        alignas(32) float s1[lanes], s2[lanes], in[lanes], out[lanes];
+        //gather targets and state from the stages
+        for (int k = 0; k < lanes; ++k) {
+            if (k < stageAmt) {
+                auto& stage = stages[k];
+                b0[k] = stage.getTargetCoeff(0);
+                b1[k] = stage.getTargetCoeff(1);
+                b2[k] = stage.getTargetCoeff(2);
+                a1[k] = stage.getTargetCoeff(3);
+                a2[k] = stage.getTargetCoeff(4);
+                s1[k] = stage.getState(channel)[0];
+                s2[k] = stage.getState(channel)[1];
+            }
+            else {
+                b0[k] = 1.0f;
+                b1[k] = b2[k] = a1[k] = a2[k] = 0.0f;
+                s1[k] = s2[k] = 0.0f;
+            }
+            out[k] = 0.0f;
+        }
+        //lane k finishes sample t - k on step t, so the last lane writes lanes - 1 behind the read position. Safe in place
+        const int n = static_cast<int>(numSamples);
+        const int totalSteps = n + lanes - 1;
+        for (int t = 0; t < totalSteps; ++t) {
+            for (int k = lanes - 1; k > 0; --k) {
+                in[k] = out[k - 1];
+            }
+            in[0] = t < n ? data[t] : 0.0f;
+            if (t >= lanes - 1 && t < n) {
+                cascadeStep<lanes, false>(b0, b1, b2, a1, a2, s1, s2, in, out, t, n);
+            }
+            else {
+                cascadeStep<lanes, true>(b0, b1, b2, a1, a2, s1, s2, in, out, t, n);
+            }
+            if (t >= lanes - 1) {
+                data[t - lanes + 1] = out[lanes - 1];
+            }
+        }
+        //scatter state back
+        for (int k = 0; k < stageAmt; ++k) {
+            auto* state = stages[k].getState(channel);
+            juce::dsp::util::snapToZero(s1[k]); state[0] = s1[k];
+            juce::dsp::util::snapToZero(s2[k]); state[1] = s2[k];
+        }
+    }
+
     std::array<EqStage, MAX_STAGES> stages;
 };
+/*
+Linkwitz-Riley crossover fed from the eq'd signal. Non-bypassed X-OVER bands are the split points (first MAX_CROSSOVER_SPLITS by band index,
+sorted by frequency) and split points + 1 bands are written to bandBuffer for the processor to copy out to the aux buses.
+
+The split is a tree: each node splits at its middle split point, so every low/high pass runs once and its output is shared by all the
+bands below it. Bands only pass through the splits on their own path, so each side of a node also gets the allpasses of the other side's
+splits once, before it splits further. That keeps the band sum flat at a cost of a few allpasses per split instead of one per band pair.
+
+prepare() allocates, update() and process() are audio thread only, same as SmoothFilter
+*/
+struct Crossover {
+    void prepare(const juce::dsp::ProcessSpec& spec) {
+        numChannels = (int)spec.numChannels;
+        bandBuffer.setSize(numChannels * MAX_CROSSOVER_BANDS, (int)spec.maximumBlockSize, false, true, false);
+        for (int s = 0; s < MAX_CROSSOVER_SPLITS; ++s) {
+            lowPasses[s].prepare(spec);
+            highPasses[s].prepare(spec);
+            for (auto& ap : allPasses[s]) {
+                ap.prepare(spec);
+            }
+        }
+    }
+    //collects split points from the filter structs, rebuilds coeffs and clears state if the tree changed shape
+    void update(const std::array<FilterInfo, MAX_FILTERS>& infos, double sr) {
+        std::array<int, MAX_CROSSOVER_SPLITS> newBands{};
+        int amt = 0;
+        for (int i = 0; i < MAX_FILTERS && amt < MAX_CROSSOVER_SPLITS; ++i) {
+            if (!infos[i].bypass.load() && infos[i].type.load() == CROSSOVER) {
+                newBands[amt++] = i;
+            }
+        }
+        //insertion sort by frequency, at most 3 entries
+        for (int i = 1; i < amt; ++i) {
+            for (int j = i; j > 0 && infos[newBands[j]].freq.load() < infos[newBands[j - 1]].freq.load(); --j) {
+                std::swap(newBands[j], newBands[j - 1]);
+            }
+        }
+        if (amt != splitAmt || newBands != splitBands) {
+            for (int s = 0; s < MAX_CROSSOVER_SPLITS; ++s) {
+                lowPasses[s].reset();
+                highPasses[s].reset();
+                for (auto& ap : allPasses[s]) {
+                    ap.reset();
+                }
+            }
+        }
+        splitAmt = amt;
+        splitBands = newBands;
+        for (int s = 0; s < splitAmt; ++s) {
+            auto& info = infos[splitBands[s]];
+            const auto freq = info.freq.load();
+            const auto bWorth = info.b_worth.load();
+            lowPasses[s].makeCrossoverHalf(sr, freq, bWorth, false);
+            highPasses[s].makeCrossoverHalf(sr, freq, bWorth, true);
+            invertHigh[s] = getCascadeStages(bWorth) % 2 == 1;
+            //allPasses[node][s] is split s's allpass as applied at the node splitting at node
+            for (auto& node : allPasses) {
+                node[s].makeCrossoverAllPass(sr, freq, bWorth);
+            }
+        }
+    }
+    //splits the block into bands, returns the amount of bands written or 0 if there are no split points
+    int process(const juce::AudioBuffer<float>& input) {
+        const int numSamples = input.getNumSamples();
+        if (splitAmt == 0 || numSamples > bandBuffer.getNumSamples()) {
+            return 0;
+        }
+        for (int ch = 0; ch < numChannels; ++ch) {
+            bandBuffer.copyFrom(ch, 0, input, juce::jmin(ch, input.getNumChannels() - 1), 0, numSamples);
+        }
+        split(0, splitAmt, (size_t)numSamples);
+        return splitAmt + 1;
+    }
+    //copies one band to a bus buffer, channels past the crossover's channel count get the last channel
+    void copyBand(int band, juce::AudioBuffer<float>& dest) const {
+        for (int ch = 0; ch < dest.getNumChannels(); ++ch) {
+            dest.copyFrom(ch, 0, bandBuffer, band * numChannels + juce::jmin(ch, numChannels - 1), 0, dest.getNumSamples());
+        }
+    }
+
+private:
+    //bands bandLo to bandHi (inclusive) are still one signal in bandLo's slot, splits between them are bandLo to bandHi - 1
+    void split(int bandLo, int bandHi, size_t numSamples) {
+        if (bandLo >= bandHi) {
+            return;
+        }
+        const int node = (bandLo + bandHi - 1) / 2;
+        auto low = getBandBlock(bandLo, numSamples);
+        auto high = getBandBlock(node + 1, numSamples);
+        high.copyFrom(low);
+        lowPasses[node].process(juce::dsp::ProcessContextReplacing<float>(low));
+        highPasses[node].process(juce::dsp::ProcessContextReplacing<float>(high));
+        if (invertHigh[node]) {
+            high.negate();
+        }
+        //each side picks up the phase of the splits it never passes through
+        for (int s = node + 1; s < bandHi; ++s) {
+            allPasses[node][s].process(juce::dsp::ProcessContextReplacing<float>(low));
+        }
+        for (int s = bandLo; s < node; ++s) {
+            allPasses[node][s].process(juce::dsp::ProcessContextReplacing<float>(high));
+        }
+        split(bandLo, node, numSamples);
+        split(node + 1, bandHi, numSamples);
+    }
+
+    juce::dsp::AudioBlock<float> getBandBlock(int band, size_t numSamples) {
+        return juce::dsp::AudioBlock<float>(bandBuffer).getSubsetChannelBlock((size_t)(band * numChannels), (size_t)numChannels).getSubBlock(0, numSamples);
+    }
+
+    std::array<SmoothFilter, MAX_CROSSOVER_SPLITS> lowPasses, highPasses;
+    std::array<std::array<SmoothFilter, MAX_CROSSOVER_SPLITS>, MAX_CROSSOVER_SPLITS> allPasses;
+    std::array<bool, MAX_CROSSOVER_SPLITS> invertHigh{};
+    //filter indices of the current split points, low to high
+    std::array<int, MAX_CROSSOVER_SPLITS> splitBands{};
+    int splitAmt = 0;
+    int numChannels = 2;
+    juce::AudioBuffer<float> bandBuffer;
+};
@@ -0,0 +1,49 @@
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/** Cached static chrome (backgrounds, div lines, outlines, labels, tick marks) for a component that repaints often
+*/
+//kept at the physical scale it was last painted at, so it's a 1:1 blit on any display. It is rendered again only when the component's
+//size or that scale changes, or when the owner invalidates it because something drawn into it moved
+struct ChromeLayer {
+    //blits the chrome, calling render(g) in the component's coords first if there's no image for this size and scale yet
+    template <typename RenderFn>
+    void draw(juce::Graphics& g, const juce::Component& c, RenderFn&& render) {
+        const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        const int w = juce::roundToInt((float)c.getWidth() * scale);
+        const int h = juce::roundToInt((float)c.getHeight() * scale);
+        if (w <= 0 || h <= 0) {
+            return;
+        }
+        if (!isCurrent(scale, w, h)) {
+            imageScale = scale;
+            image = juce::Image(juce::Image::ARGB, w, h, true);
+            juce::Graphics ig(image);
+            ig.addTransform(juce::AffineTransform::scale(scale));
+            render(ig);
+        }
+        g.drawImageTransformed(image, juce::AffineTransform::scale(1.0f / imageScale));
+    }
+
+    //next draw renders again
+    void invalidate() {
+        image = {};
+    }
+
+    //true when draw would only blit, for owners that put off the first render
+    bool isCurrent(juce::Graphics& g, const juce::Component& c) const {
+        const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        return isCurrent(scale, juce::roundToInt((float)c.getWidth() * scale), juce::roundToInt((float)c.getHeight() * scale));
+    }
+
+private:
+    bool isCurrent(float scale, int w, int h) const {
+        return image.isValid() && scale == imageScale && image.getWidth() == w && image.getHeight() == h;
+    }
+
+    juce::Image image;
+    float imageScale = 1.0f;
+};
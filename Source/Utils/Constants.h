@@ -41,11 +41,18 @@ inline constexpr int GAIN_X = 10 + MAX_FILTERS;
 inline constexpr int GAIN_Y = 11 + MAX_FILTERS;
 inline constexpr int SETTINGS_X = 12 + MAX_FILTERS;
 inline constexpr int SETTINGS_Y = 13 + MAX_FILTERS;
+inline constexpr int ANALYSER_CHANNEL = 14 + MAX_FILTERS;
+inline constexpr int SPECTROGRAM_ON = 15 + MAX_FILTERS;
+inline constexpr int ANALYSER_AVERAGE = 16 + MAX_FILTERS;
+inline constexpr int ANALYSER_FILL = 17 + MAX_FILTERS;
+inline constexpr int ANALYSER_SMOOTHING = 18 + MAX_FILTERS;
+inline constexpr int CURVE_TRACES = 19 + MAX_FILTERS;
+inline constexpr int UI_SCALE = 20 + MAX_FILTERS;
 //filter coefficient specific variables
 //2nd order has 6 but juce internally filters out one of them(a0)
 inline constexpr int COEFF_SIZE = 6 - 1;
 inline constexpr int FILTER_ORDER = 2;
-inline constexpr int MAX_STAGES = 4;
+inline constexpr int MAX_STAGES = 8;
 inline constexpr float COEFF_RAMP_TIME = 0.012f;
 //filter types
 inline constexpr int PEAK = 0;
@@ -56,16 +63,82 @@ inline constexpr int LOWPASS_Q = 4;
 inline constexpr int HIGHSHELF = 5;
 inline constexpr int LOWSHELF = 6;
 inline constexpr int NOTCH = 7;
+inline constexpr int CROSSOVER = 8;
+//crossover split points, each X-OVER band adds one and outputs go to MAX_CROSSOVER_SPLITS + 1 aux buses
+inline constexpr int MAX_CROSSOVER_SPLITS = 3;
+inline constexpr int MAX_CROSSOVER_BANDS = MAX_CROSSOVER_SPLITS + 1;
 //front end timings
 inline constexpr int TOOLTIP_DELAY_MS = 200;
 inline constexpr int TIMER_FPS = 30;
+//views step at TIMER_FPS on whichever vblank lands within this much of the next step
+inline constexpr double FRAME_SLACK_MS = 2.0;
+//an analyser that hasn't had a frame picked up in this long (hidden, minimized, off screen, vblanks stopped) is skipped by the worker
+inline constexpr juce::uint32 ANALYSER_IDLE_MS = 250;
+//response curve sampling: each band starts from a coarse grid plus points around its centre, then bisects (x on the 0 to 1 log freq
+//range) until straight lines between samples are within the tolerance. capped per band so a pathological band can't run away
+inline constexpr int CURVE_GRID_STEPS = 24;
+inline constexpr float CURVE_SAMPLE_TOL_DB = 0.05f;
+inline constexpr double CURVE_MIN_STEP = 1.0 / 4096.0;
+inline constexpr int CURVE_MAX_SAMPLES = 1024;
+//a band's change only repaints where it moves the curve by more than this many pixels, widened by the stroke
+inline constexpr float CURVE_STROKE = 3.0f;
+inline constexpr float CURVE_DIRTY_PX = 0.5f;
+//extra response curve traces: phase wrapped to +-180 degrees over the full height, group delay from 0 at the bottom to the range at the
+//top. with either on, bisection also splits where a straight line misses the midpoint's phase or delay by more than these
+inline constexpr int CURVE_TRACES_OFF = 0;
+inline constexpr int CURVE_TRACES_PHASE = 1;
+inline constexpr int CURVE_TRACES_DELAY = 2;
+inline constexpr int CURVE_TRACES_BOTH = 3;
+inline constexpr int CURVE_TRACES_AMT = 4;
+inline constexpr float CURVE_DELAY_RANGE_MS = 20.0f;
+inline constexpr float CURVE_SAMPLE_TOL_PHASE = 0.005f;
+inline constexpr float CURVE_SAMPLE_TOL_MS = 0.02f;
 //fft/analyser configs
-//would love for this to be 14, or at least get a better way to deal with the low end
+//low end detail comes from the decimated low band below MID_FREQ instead of a bigger fft
 inline constexpr int FFT_ORDER = 13;
 inline constexpr int FFT_SIZE = 1 << FFT_ORDER;
 inline constexpr int FFT_HOP_AMT = 4;
 inline constexpr int FFT_HOP_SIZE = FFT_SIZE / FFT_HOP_AMT;
 inline constexpr int FFT_BIN_AMT = FFT_SIZE / 2 + 1;
+//analyser ring holds a window plus ~40 ms at 192k per tap, so the worker never drops samples between passes
+inline constexpr int FFT_RING_SIZE = FFT_SIZE * 2;
+//analyser modes, PRE and POST line up with the old pre/post bool so saved states load the same
+inline constexpr int ANALYSER_PRE = 0;
+inline constexpr int ANALYSER_POST = 1;
+inline constexpr int ANALYSER_DUAL = 2;
+inline constexpr int ANALYSER_DELTA = 3;
+inline constexpr int ANALYSER_MODE_AMT = 4;
+//analyser channel modes, MID is the old (L + R) / 2 downmix. L+R overlays left and right of the pre tap in PRE mode, post otherwise
+inline constexpr int ANALYSER_MID = 0;
+inline constexpr int ANALYSER_SIDE = 1;
+inline constexpr int ANALYSER_LEFT = 2;
+inline constexpr int ANALYSER_RIGHT = 3;
+inline constexpr int ANALYSER_LR = 4;
+inline constexpr int ANALYSER_CHANNEL_AMT = 5;
+//the ring carries two streams as interleaved frames, pre and post of one channel or left and right for L+R. the worker packs them
+//into one complex fft, the delta trace comes from their two frames and the hold trace accumulates the main one
+inline constexpr int ANALYSER_TAPS = 2;
+inline constexpr int ANALYSER_DELTA_TRACE = ANALYSER_TAPS;
+inline constexpr int ANALYSER_HOLD_TRACE = ANALYSER_TAPS + 1;
+inline constexpr int ANALYSER_TRACES = ANALYSER_TAPS + 2;
+//hold trace modes: off, max-hold, exponential long-term average, and a running mean of everything since the last reset
+inline constexpr int ANALYSER_AVG_OFF = 0;
+inline constexpr int ANALYSER_AVG_MAX = 1;
+inline constexpr int ANALYSER_AVG_LONG = 2;
+inline constexpr int ANALYSER_AVG_INTEGRATED = 3;
+inline constexpr int ANALYSER_AVG_AMT = 4;
+inline constexpr double ANALYSER_LONG_AVG_SECONDS = 3.0;
+//fractional octave smoothing, off keeps the raw rms / cubic pixels. octave width of each option
+inline constexpr int ANALYSER_SMOOTH_OFF = 0;
+inline constexpr int ANALYSER_SMOOTH_AMT = 6;
+inline constexpr float ANALYSER_SMOOTH_OCTAVES[ANALYSER_SMOOTH_AMT] = { 0.0f, 1.0f / 24.0f, 1.0f / 12.0f, 1.0f / 6.0f, 1.0f / 3.0f, 1.0f };
+//widest smoothing reaches half an octave past a pixel, so the low band keeps bins up to MID_FREQ * 2^(1/2)
+inline constexpr float ANALYSER_SMOOTH_REACH = 1.41421356f;
+//low band is decimated by the largest power of two that keeps it at or above this rate (~1.4 Hz bins at any sample rate)
+inline constexpr double LOW_BAND_MIN_RATE = 11025.0;
+inline constexpr int MAX_DECIMATION_STAGES = 5;
+//spectrogram colour steps from MIN_ANALYSIS_DB to 0
+inline constexpr int SPECTROGRAM_PALETTE_SIZE = 256;
 inline constexpr float FFT_SLOPE = 4.5f;
 inline constexpr int FFT_ATTACK = 20;
 inline constexpr int FFT_RELEASE = 3;
@@ -82,6 +155,12 @@ inline constexpr int CREDIT_WINDOW_WIDTH = 900;
 inline constexpr int CREDIT_WINDOW_HEIGHT = 500;
 inline constexpr int HELP_WINDOW_WIDTH = 1020;
 inline constexpr int HELP_WINDOW_HEIGHT = 650;
+//ui scale modes. the editor is always laid out at the window dims above and shown scaled down as a whole, large is that size
+inline constexpr int UI_SCALE_LARGE = 0;
+inline constexpr int UI_SCALE_MEDIUM = 1;
+inline constexpr int UI_SCALE_SMALL = 2;
+inline constexpr int UI_SCALE_AMT = 3;
+inline constexpr float UI_SCALES[UI_SCALE_AMT] = { 1.0f, 0.85f, 0.7f };
 inline constexpr int METER_AREA_WIDTH = MAIN_WINDOW_WIDTH / 16;
 //button dims
 inline constexpr int MINIMIZE_BUTTON_DIM = 20;
@@ -116,10 +195,10 @@ inline constexpr int GAIN_SIZE_X = 140;
 inline constexpr int GAIN_SIZE_Y = 120;
 inline constexpr int GAIN_TOPLEFT_X = 945;
 inline constexpr int GAIN_TOPLEFT_Y = 520;
-inline constexpr int SETTINGS_SIZE_X = 210;
-inline constexpr int SETTINGS_SIZE_Y = 120;
+inline constexpr int SETTINGS_SIZE_X = 400;
+inline constexpr int SETTINGS_SIZE_Y = 190;
 inline constexpr int SETTINGS_TOPLEFT_X = 25;
-inline constexpr int SETTINGS_TOPLEFT_Y = 520;
+inline constexpr int SETTINGS_TOPLEFT_Y = 450;
 inline constexpr int SELECTED_SIZE_X = 210;
 inline constexpr int SELECTED_SIZE_Y = 220;
 inline constexpr int SELECTED_TOPLEFT_X = 425;
@@ -143,10 +222,25 @@ inline juce::StringArray params{ "1Freq", "1Gain", "1Quality", "1Type", "1dB/Oct
 //property names to call easily when dealing with value tree
 inline juce::StringArray props{ "1Init", "2Init", "3Init", "4Init", "5Init", "6Init", "7Init", "8Init", "9Init", "10Init", "11Init", "12Init",
                                 "analyserOn", "analyserMode", "peakOn", "peakMode", "minimizeGain", "minimizeSelectedFilter", "minimizeConfigs", 
-                                "selectedFilter", "selectedX", "selectedY", "gainX", "gainY", "settingsX", "settingsY" };
+                                "selectedFilter", "selectedX", "selectedY", "gainX", "gainY", "settingsX", "settingsY", "analyserChannel", "spectrogramOn",
+                                "analyserAverage", "analyserFill", "analyserSmoothing", "curveTraces", "uiScale" };
 //eq filter type list and butterworth dB/octave lists for audio parameter choices, only used by the processor
-inline juce::StringArray filterTypes{ "PEAK", "HI-PASS\n(dB/OCT)", "LO-PASS\n(dB/OCT)", "HI-PASS\n(Q)", "LO-PASS\n(Q)", "HI-SHLF", "LO-SHLF", "NOTCH" };
-inline juce::StringArray b_worths{ "12dB/OCT", "24dB/OCT", "36dB/OCT", "48dB/OCT" };
+inline juce::StringArray filterTypes{ "PEAK", "HI-PASS\n(dB/OCT)", "LO-PASS\n(dB/OCT)", "HI-PASS\n(Q)", "LO-PASS\n(Q)", "HI-SHLF", "LO-SHLF", "NOTCH", "X-OVER" };
+//analyser mode button text, indexed by ANALYSER_PRE..ANALYSER_DELTA
+inline juce::StringArray analyserModes{ "PRE", "POST", "BOTH", "DELTA" };
+//analyser channel button text, indexed by ANALYSER_MID..ANALYSER_LR
+inline juce::StringArray analyserChannels{ "MID", "SIDE", "L", "R", "L+R" };
+//analyser hold trace button text, indexed by ANALYSER_AVG_OFF..ANALYSER_AVG_INTEGRATED
+inline juce::StringArray analyserAverages{ "LIVE", "MAX", "AVG", "INT" };
+//analyser smoothing button text, indexed like ANALYSER_SMOOTH_OCTAVES
+inline juce::StringArray analyserSmoothings{ "RAW", "1/24", "1/12", "1/6", "1/3", "1/1" };
+//response curve extra trace button text, indexed by CURVE_TRACES_OFF..CURVE_TRACES_BOTH
+inline juce::StringArray curveTraces{ "MAG", "PHASE", "DELAY", "PH+GD" };
+//ui scale button text, indexed by UI_SCALE_LARGE..UI_SCALE_SMALL
+inline juce::StringArray uiScales{ "L", "M", "S" };
+//first MAX_STAGES choices are Butterworth, the next MAX_STAGES are Linkwitz-Riley. Each step is one more biquad (12 dB/oct)
+inline juce::StringArray b_worths{ "12dB/OCT", "24dB/OCT", "36dB/OCT", "48dB/OCT", "60dB/OCT", "72dB/OCT", "84dB/OCT", "96dB/OCT",
+                                   "LR 12dB/OCT", "LR 24dB/OCT", "LR 36dB/OCT", "LR 48dB/OCT", "LR 60dB/OCT", "LR 72dB/OCT", "LR 84dB/OCT", "LR 96dB/OCT" };
 
 //==============================================================================
 /** Formatting and range templates
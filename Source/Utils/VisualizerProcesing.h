@@ -4,7 +4,8 @@
 //==============================================================================
 /** ANALYSIS TOOLS
 */
-//abstract FIFO for the analyser
+//abstract FIFO ring for the analyser. needs at least FFT_SIZE + FFT_HOP_SIZE frames so a full window can stay in it while the next hop
+//is written. multi channel data is interleaved in whole frames, so capacity must be a multiple of the channel count
 template <typename T>
 struct Fifo {
     Fifo(int capacity) : fifo(capacity) {
@@ -15,19 +16,49 @@ struct Fifo {
         buffer.free();
     }
 
-    //pops to spec component buffer
-    int pop(T* dest, int numToRead) {
+    //deinterleaves and consumes numFrames frames, a null dest skips that channel. used for the hop after a frame and for hops the
+    //reader fell behind on
+    int popFrames(T* const* dest, const int numFrames, const int numChannels) {
         int start1, size1, start2, size2;
-        fifo.prepareToRead(numToRead, start1, size1, start2, size2);
-        int numRead = size1 + size2;
+        fifo.prepareToRead(numFrames * numChannels, start1, size1, start2, size2);
+        //regions always split on a frame boundary since everything is written and read in whole frames
+        const int frames1 = size1 / numChannels;
+        const int frames2 = size2 / numChannels;
+        for (int c = 0; c < numChannels; ++c) {
+            if (T* d = dest[c]) {
+                for (int i = 0; i < frames1; ++i) {
+                    d[i] = buffer[start1 + i * numChannels + c];
+                }
+                for (int i = 0; i < frames2; ++i) {
+                    d[frames1 + i] = buffer[start2 + i * numChannels + c];
+                }
+            }
+        }
+        fifo.finishedRead(size1 + size2);
+        return frames1 + frames2;
+    }
+
+    //windowed read straight out of the ring: once size values are ready, multiply them by the window into dest and only consume hop of
+    //them. the rest stay for the next overlapping frame, the writer can't touch them since they were never consumed. a hop of 0 just
+    //peeks. interleaved pairs read as complex (re, im) values with a window that repeats each point twice
+    bool readWindow(T* dest, const T* windowTable, const int size, const int hop) {
+        if (fifo.getNumReady() < size) {
+            return false;
+        }
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(size, start1, size1, start2, size2);
         if (size1 > 0) {
-            std::copy(buffer + start1, buffer + start1 + size1, dest);
+            juce::FloatVectorOperations::multiply(dest, buffer + start1, windowTable, size1);
         }
         if (size2 > 0) {
-            std::copy(buffer + start2, buffer + start2 + size2, dest + size1);
+            juce::FloatVectorOperations::multiply(dest + size1, buffer + start2, windowTable + size1, size2);
         }
-        fifo.finishedRead(numRead);
-        return numRead;
+        fifo.finishedRead(hop);
+        return true;
+    }
+
+    int getNumReady() const {
+        return fifo.getNumReady();
     }
 
     //clear on prepare
@@ -35,45 +66,304 @@ struct Fifo {
         fifo.reset();
     }
 
-    //called in process block to push all buffer samples based on channel amount
-    void getBufferSamples(const T* left, const T* right, const int numSamples) {
-        if (right) {
-            for (int i = 0; i < numSamples; ++i) {
-                pushSample((left[i] + right[i]) * 0.5f);
+    //push two streams as interleaved frames (a0, b0, a1, b1...), one prepare/finish per block and whatever doesn't fit is dropped.
+    //only whole frames are written, free space can be odd
+    void pushInterleaved(const T* a, const T* b, const int numSamples) {
+        const int numFrames = juce::jmin(numSamples, fifo.getFreeSpace() / 2);
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(numFrames * 2, start1, size1, start2, size2);
+        const int frames1 = size1 / 2;
+        for (int i = 0; i < frames1; ++i) {
+            buffer[start1 + 2 * i] = a[i];
+            buffer[start1 + 2 * i + 1] = b[i];
+        }
+        for (int i = 0; i < size2 / 2; ++i) {
+            buffer[start2 + 2 * i] = a[frames1 + i];
+            buffer[start2 + 2 * i + 1] = b[frames1 + i];
+        }
+        fifo.finishedWrite(size1 + size2);
+    }
+
+    //the processor's taps are written straight into the ring's frames in three steps, so a tap taken before the eq and one taken after it
+    //land in the same frames without staging either of them. beginFrames reserves up to numFrames and returns how many fit, writeTap mixes
+    //one tap into its slot of every reserved frame, and finishFrames hands them all to the reader at once. writer thread only, the reader
+    //can't see reserved frames until they're finished
+    int beginFrames(const int numFrames) {
+        fifo.prepareToWrite(juce::jmin(numFrames, fifo.getFreeSpace() / 2) * 2, writeStart1, writeSize1, writeStart2, writeSize2);
+        return (writeSize1 + writeSize2) / 2;
+    }
+
+    //one analyser channel out of a block into tap 0 or 1 of the reserved frames: MID (L + R) / 2, SIDE (L - R) / 2, or either side. mono
+    //is its own mid and has no side
+    void writeTap(const int tap, const T* left, const T* right, const int channel) {
+        //regions always split on a frame boundary since everything is written and read in whole frames
+        const int frames1 = writeSize1 / 2;
+        mixChannel(buffer + writeStart1 + tap, left, right, frames1, channel);
+        mixChannel(buffer + writeStart2 + tap, left + frames1, right ? right + frames1 : nullptr, writeSize2 / 2, channel);
+    }
+
+    void finishFrames() {
+        fifo.finishedWrite(writeSize1 + writeSize2);
+        writeSize1 = writeSize2 = 0;
+    }
+
+private:
+    //mixes into every other value from dest
+    static void mixChannel(T* dest, const T* left, const T* right, const int num, const int channel) {
+        if (!right) {
+            const T gain = channel == ANALYSER_SIDE ? (T)0 : (T)1;
+            for (int i = 0; i < num; ++i) {
+                dest[2 * i] = left[i] * gain;
             }
+            return;
+        }
+        switch (channel) {
+            case ANALYSER_SIDE:
+                for (int i = 0; i < num; ++i) {
+                    dest[2 * i] = (left[i] - right[i]) * (T)0.5;
+                }
+                break;
+            case ANALYSER_LEFT:
+                for (int i = 0; i < num; ++i) {
+                    dest[2 * i] = left[i];
+                }
+                break;
+            case ANALYSER_RIGHT:
+                for (int i = 0; i < num; ++i) {
+                    dest[2 * i] = right[i];
+                }
+                break;
+            default:
+                for (int i = 0; i < num; ++i) {
+                    dest[2 * i] = (left[i] + right[i]) * (T)0.5;
+                }
+                break;
+        }
+    }
+
+    juce::AbstractFifo fifo;
+    juce::HeapBlock<T> buffer;
+    //frames reserved by beginFrames, as values
+    int writeStart1 = 0, writeSize1 = 0, writeStart2 = 0, writeSize2 = 0;
+};
+
+//10 * log10 of a power array, floored at floorDb. log2 comes from the float's exponent plus a cubic fit on the mantissa (< .003 dB off),
+//branch free so the loop vectorizes, and it's only ever run once per bin or pixel per frame
+inline void powerToDecibels(float* dest, const float* power, const int num, const float floorDb) {
+    const float minPower = std::pow(10.0f, floorDb * 0.1f);
+    for (int i = 0; i < num; ++i) {
+        float x = juce::jmax(power[i], minPower);
+        uint32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        const float exponent = (float)((int)(bits >> 23) - 127);
+        bits = (bits & 0x007FFFFFu) | 0x3F800000u;
+        float m;
+        std::memcpy(&m, &bits, sizeof(m));
+        const float log2m = -2.16417091f + m * (3.06469662f + m * (-1.05974583f + m * 0.15922012f));
+        //10 * log10(2)
+        dest[i] = (exponent + log2m) * 3.01029996f;
+    }
+}
+
+//bins a pixel reads, rebuilt with the pixel mapping. cubic pixels interpolate dB around lo by mu, the rest average power over [lo, hi]
+struct PixelSpan {
+    int lo = 0;
+    int hi = 0;
+    float mu = 0.0f;
+    bool cubic = false;
+};
+
+//spans for pixels first to last of a width px log freq axis at binsPerHz, clamped to maxBin. cubic is allowed while a pixel is narrower
+//than a bin
+inline void mapPixelSpans(std::vector<PixelSpan>& spans, int first, int last, int width, float binsPerHz, int maxBin, bool allowCubic) {
+    spans.resize(juce::jmax(0, last - first));
+    auto binAt = [&](int pixel) {
+        float freq = freqRange.convertFrom0to1((float)juce::jmax(0, pixel) / (float)(width - 1));
+        return juce::jlimit(0.0f, (float)maxBin, freq * binsPerHz);
+    };
+    for (int i = first; i < last; ++i) {
+        const float center = binAt(i);
+        const float prev = binAt(i - 1);
+        auto& span = spans[i - first];
+        span.cubic = allowCubic && (i == 0 || center - prev <= 1.0f);
+        if (span.cubic) {
+            span.lo = (int)center;
+            span.hi = span.lo;
+            span.mu = center - (float)span.lo;
         }
         else {
-            pushBlock(left, numSamples);
+            //never overlap rms, a pixel narrower than a bin at high sample rates just uses its bin
+            span.hi = (int)center;
+            span.lo = juce::jmin((int)prev + 1, span.hi);
+            span.mu = 0.0f;
         }
     }
+}
+
+//Catmull-Rom spline interpolation
+inline float cubicInterpolate(float y0, float y1, float y2, float y3, float mu) {
+    float mu2 = mu * mu;
+    float a0 = -0.5f * y0 + 1.5f * y1 - 1.5f * y2 + 0.5f * y3;
+    float a1 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
+    float a2 = -0.5f * y0 + 0.5f * y2;
+    float a3 = y1;
+
+    return a0 * mu * mu2 + a1 * mu2 + a2 * mu + a3;
+}
+
+//average bin power over each span into pixelPower, one dB pass into dest, then cubic pixels from binDb when it's passed
+inline void buildSpanPixels(const PixelSpan* spans, const int num, const float* power, const float* binDb, float* pixelPower, float* dest) {
+    //mean power over each span, same as the old rms squared. cubic pixels are filled in after
+    for (int i = 0; i < num; ++i) {
+        const auto& span = spans[i];
+        float sum = 0.0f;
+        if (!span.cubic) {
+            for (int b = span.lo; b <= span.hi; ++b) {
+                sum += power[b];
+            }
+            sum /= (float)(span.hi - span.lo + 1);
+        }
+        pixelPower[i] = sum;
+    }
+    powerToDecibels(dest, pixelPower, num, MIN_ANALYSIS_DB);
+    if (!binDb) {
+        return;
+    }
+    //cubic interpolation between bins already in dB, shared bins aren't converted again
+    for (int i = 0; i < num; ++i) {
+        const auto& span = spans[i];
+        if (span.cubic) {
+            dest[i] = cubicInterpolate(binDb[juce::jmax(0, span.lo - 1)], binDb[span.lo], binDb[span.lo + 1], binDb[span.lo + 2], span.mu);
+        }
+    }
+}
+
+//power of two streams packed into one complex fft as a + ib, scaled per bin. A[k] = (Z[k] + conj(Z[N - k])) / 2 and
+//B[k] = (Z[k] - conj(Z[N - k])) / 2i, only power is kept so the 1 / i drops out and both are |.|^2 / 4. fftSize is a power of 2
+inline void splitPackedSpectrum(const juce::dsp::Complex<float>* spectrum, const int fftSize, const float* scalars, const int numBins,
+                                float* powerA, float* powerB) {
+    for (int k = 0; k < numBins; ++k) {
+        const auto z = spectrum[k];
+        const auto zc = std::conj(spectrum[(fftSize - k) & (fftSize - 1)]);
+        const float scale = scalars[k] * 0.25f;
+        powerA[k] = std::norm(z + zc) * scale;
+        powerB[k] = std::norm(z - zc) * scale;
+    }
+}
+
+//half-band lowpass that keeps every other sample. 23 tap kaiser design, flat to .2 fs and ~-99 dB from .8 fs, which is all the low band
+//needs since only the bottom of the last decimated band is ever drawn
+struct HalfBandDecimator {
+    void reset() {
+        std::fill(std::begin(delay), std::end(delay), 0.0f);
+        pos = 0;
+        odd = false;
+    }
+
+    //in place is fine, the output never overtakes the input. returns samples written
+    int process(const float* in, float* out, const int numSamples) {
+        int numOut = 0;
+        for (int i = 0; i < numSamples; ++i) {
+            //doubled delay line so the taps are always one contiguous read, x[0] is newest
+            pos = (pos == 0 ? NUM_TAPS : pos) - 1;
+            delay[pos] = delay[pos + NUM_TAPS] = in[i];
+            odd = !odd;
+            if (odd) {
+                continue;
+            }
+            //every other tap is zero apart from the center
+            const float* x = delay + pos;
+            float acc = 0.5f * x[CENTER];
+            for (int k = 0; k < SIDE_TAPS; ++k) {
+                acc += coeffs[k] * (x[CENTER - 1 - 2 * k] + x[CENTER + 1 + 2 * k]);
+            }
+            out[numOut++] = acc;
+        }
+        return numOut;
+    }
 
 private:
-    void pushSample(T sample) {
-        int start1, size1, start2, size2;
-        fifo.prepareToWrite(1, start1, size1, start2, size2);
-        if (size1 > 0) {
-            buffer[(size_t)start1] = sample;
+    static constexpr int SIDE_TAPS = 6;
+    static constexpr int NUM_TAPS = 4 * SIDE_TAPS - 1;
+    static constexpr int CENTER = NUM_TAPS / 2;
+    inline static constexpr float coeffs[SIDE_TAPS] = { 3.057346573e-01f, -7.338464533e-02f, 2.204426104e-02f,
+                                                        -4.991593480e-03f, 6.043985615e-04f, -8.106001362e-06f };
+    float delay[NUM_TAPS * 2] = {};
+    int pos = 0;
+    bool odd = false;
+};
+
+//cascaded half-bands for the analyser low band, decimates by 2^numStages
+struct DecimatorCascade {
+    void setNumStages(int n) {
+        numStages = juce::jlimit(0, MAX_DECIMATION_STAGES, n);
+        reset();
+    }
+
+    void reset() {
+        for (auto& stage : stages) {
+            stage.reset();
         }
-        if (size2 > 0) {
-            buffer[(size_t)start2] = sample;
+    }
+
+    int getFactor() const {
+        return 1 << numStages;
+    }
+
+    //decimates in place, returns samples left
+    int process(float* data, int numSamples) {
+        for (int s = 0; s < numStages; ++s) {
+            numSamples = stages[s].process(data, data, numSamples);
         }
-        fifo.finishedWrite(size1 + size2);
+        return numSamples;
     }
 
-    void pushBlock(const T* block, const int numSamples) {
-        int start1, size1, start2, size2;
-        fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
-        if (size1 > 0) {
-            std::memcpy(buffer + start1, block, size1);
+private:
+    HalfBandDecimator stages[MAX_DECIMATION_STAGES];
+    int numStages = 0;
+};
+
+//per bin accumulation of power for the analyser's hold trace. max-hold keeps the loudest, the long-term average is an exponential one
+//that starts as a plain mean until 1 / n drops under its coefficient, and integrated is a Welford running mean over everything since
+//the last reset. one float per bin whatever the length
+struct SpectrumAccumulator {
+    void setSize(int numBins) {
+        values.assign(numBins, 0.0f);
+        count = 0;
+    }
+
+    void reset() {
+        std::fill(values.begin(), values.end(), 0.0f);
+        count = 0;
+    }
+
+    //longAlpha is the per frame coefficient for ANALYSER_AVG_LONG
+    void add(const float* power, const int mode, const float longAlpha) {
+        const int num = (int)values.size();
+        ++count;
+        if (mode == ANALYSER_AVG_MAX) {
+            juce::FloatVectorOperations::max(values.data(), values.data(), power, num);
+            return;
         }
-        if (size2 > 0) {
-            std::memcpy(buffer + start2, block, size2);
+        //mean += (x - mean) / n, the long average stops shrinking its step at longAlpha
+        float alpha = (float)(1.0 / (double)count);
+        if (mode == ANALYSER_AVG_LONG) {
+            alpha = juce::jmax(alpha, longAlpha);
+        }
+        float* mean = values.data();
+        for (int i = 0; i < num; ++i) {
+            mean[i] += (power[i] - mean[i]) * alpha;
         }
-        fifo.finishedWrite(size1 + size2);
     }
 
-    juce::AbstractFifo fifo;
-    juce::HeapBlock<T> buffer;
+    const float* data() const {
+        return values.data();
+    }
+
+private:
+    std::vector<float> values;
+    //double so a song's worth of frames still steps the mean by exactly 1 / n
+    double count = 0;
 };
 
 //peak structs to pass peaks of each block to peak UI component
@@ -101,3 +391,43 @@ private:
         while (newValue > oldValue && !value.compare_exchange_weak(oldValue, newValue, std::memory_order_release, std::memory_order_relaxed));
     }
 };
+
+//==============================================================================
+/** RESPONSE CURVE TOOLS
+*/
+//squared magnitude of H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2) in terms of phi = sin^2(w / 2):
+//|H|^2 = ((b0 + b1 + b2)^2 - 4 (b0 b1 + 4 b0 b2 + b1 b2) phi + 16 b0 b2 phi^2) / (same with 1, a1, a2)
+//the phi form keeps its precision at low frequencies where cos(w) is ~1 and the cos form cancels out. Multiplies one stage (b0, b1, b2,
+//a1, a2) into prereset mags (all at 1.0).
+//for phase, each polynomial times e^(jw) is (b1 + (b0 + b2) cos w) + j (b0 - b2) sin w, and the e^(jw)s cancel. Differentiating that
+//angle gives the group delay per polynomial as (b0 - b2)(b0 + b2 + b1 cos w) / |B|^2, no atan or finite differences, and |B|^2 is the
+//same phi form as above so it stays accurate at the low end. tau = that of the denominator minus that of the numerator, in samples.
+//phase and delay are only added in when a sin(w) table is passed
+inline void multiplyStageResponse(const float* coeffs, const double* phi, const double* sinW, double* mags, double* phases, double* delays,
+                                  int num) noexcept {
+    const double b0 = coeffs[0], b1 = coeffs[1], b2 = coeffs[2], a1 = coeffs[3], a2 = coeffs[4];
+    const double bSum = b0 + b1 + b2;
+    const double aSum = 1.0 + a1 + a2;
+    const double n0 = bSum * bSum, n1 = -4.0 * (b0 * b1 + 4.0 * b0 * b2 + b1 * b2), n2 = 16.0 * b0 * b2;
+    const double d0 = aSum * aSum, d1 = -4.0 * (a1 + 4.0 * a2 + a1 * a2), d2 = 16.0 * a2;
+    if (!sinW) {
+        //no branches or calls, so it vectorizes over points
+        for (int i = 0; i < num; ++i) {
+            const double x = phi[i];
+            mags[i] *= (n0 + x * (n1 + x * n2)) / (d0 + x * (d1 + x * d2));
+        }
+        return;
+    }
+    const double bOuter = b0 + b2, bDiff = b0 - b2;
+    const double aOuter = 1.0 + a2, aDiff = 1.0 - a2;
+    for (int i = 0; i < num; ++i) {
+        const double x = phi[i];
+        const double c = 1.0 - 2.0 * x;
+        //a zero on the unit circle has no defined delay, the floor just keeps it finite
+        const double numSq = juce::jmax(n0 + x * (n1 + x * n2), 1.0e-30);
+        const double denSq = juce::jmax(d0 + x * (d1 + x * d2), 1.0e-30);
+        mags[i] *= numSq / denSq;
+        phases[i] += std::atan2(bDiff * sinW[i], b1 + bOuter * c) - std::atan2(aDiff * sinW[i], a1 + aOuter * c);
+        delays[i] += aDiff * (aOuter + a1 * c) / denSq - bDiff * (bOuter + b1 * c) / numSq;
+    }
+}
@@ -0,0 +1,184 @@
+#include <JuceHeader.h>
+#include "Utils/Constants.h"
+#include "Utils/VisualizerProcesing.h"
+
+//==============================================================================
+/** Analyser frame building: powerToDecibels against 10 * log10, span pixels against a per pixel log10 reference, plus a benchmark of
+    one frame of both taps built from a fixed spectrum at 48 kHz, against the per pixel conversion it replaced
+*/
+struct AnalyserFrameTests : juce::UnitTest {
+    AnalyserFrameTests() : juce::UnitTest("Analyser Frame", "Semi-Pro-Q") {}
+
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int benchmarkReps = 500;
+
+    void runTest() override {
+        beginTest("powerToDecibels is within .003 dB of 10 * log10");
+        {
+            //log spaced from the floor up past 0 dB, and under the floor where it has to clamp
+            constexpr int num = 100000;
+            std::vector<float> power(num), db(num);
+            for (int i = 0; i < num; ++i) {
+                power[i] = std::pow(10.0f, (MIN_ANALYSIS_DB + 120.0f * (float)i / (float)(num - 1)) * 0.1f);
+            }
+            powerToDecibels(db.data(), power.data(), num, MIN_ANALYSIS_DB);
+            double maxDiff = 0.0;
+            for (int i = 0; i < num; ++i) {
+                maxDiff = juce::jmax(maxDiff, std::abs((double)db[i] - 10.0 * std::log10((double)power[i])));
+            }
+            expectLessThan(maxDiff, 0.003);
+            const float quiet[] = { 0.0f, 1.0e-20f };
+            float quietDb[2];
+            powerToDecibels(quietDb, quiet, 2, MIN_ANALYSIS_DB);
+            expectLessThan(std::abs(quietDb[0] - MIN_ANALYSIS_DB), 0.003f);
+            expectLessThan(std::abs(quietDb[1] - MIN_ANALYSIS_DB), 0.003f);
+        }
+
+        Spectrum spectrum;
+        //frame widths of the S and L window scales, the component builds width / 2 + 1 pixels
+        for (int width : { 547, 1093 }) {
+            Frame frame(width);
+
+            beginTest("Span pixels match the per pixel log10 reference at " + juce::String(width) + " px");
+            frame.build(spectrum);
+            const auto fast = frame.pixelDb;
+            frame.buildReference(spectrum);
+            double maxDiff = 0.0;
+            for (size_t i = 0; i < fast.size(); ++i) {
+                maxDiff = juce::jmax(maxDiff, std::abs((double)fast[i] - (double)frame.pixelDb[i]));
+            }
+            //the cubic weights sum to at most ~1.3 in magnitude, so its pixels can be a bit further off than the .003 of a conversion
+            expectLessThan(maxDiff, 0.005);
+
+            beginTest("Benchmark at " + juce::String(width) + " px");
+            juce::PerformanceCounter fastCounter("span", benchmarkReps + 1), referenceCounter("reference", benchmarkReps + 1);
+            for (int r = 0; r < benchmarkReps; ++r) {
+                fastCounter.start();
+                frame.build(spectrum);
+                fastCounter.stop();
+                referenceCounter.start();
+                frame.buildReference(spectrum);
+                referenceCounter.stop();
+            }
+            const auto fastStats = fastCounter.getStatisticsAndReset();
+            const auto referenceStats = referenceCounter.getStatisticsAndReset();
+            logMessage("split, spans and dB of both taps, per pixel log10 " + juce::String(referenceStats.averageSeconds * 1.0e6, 1)
+                       + " us, span pixels " + juce::String(fastStats.averageSeconds * 1.0e6, 1) + " us");
+        }
+    }
+
+private:
+    //packed spectra of the full rate and low band ffts. a fixed lcg with a 1 / f tilt so pixels cover most of the dB range
+    struct Spectrum {
+        Spectrum() : full(FFT_SIZE), low(FFT_SIZE) {
+            uint32_t state = 12345u;
+            auto next = [&]() {
+                state = state * 1664525u + 1013904223u;
+                return (float)(state >> 8) / (float)(1u << 24) - 0.5f;
+            };
+            for (int k = 0; k < FFT_SIZE; ++k) {
+                const float tilt = 2000.0f / (float)(juce::jmin(k, FFT_SIZE - k) + 1);
+                full[k] = { next() * tilt, next() * tilt };
+                low[k] = { next() * tilt, next() * tilt };
+            }
+        }
+
+        std::vector<juce::dsp::Complex<float>> full, low;
+    };
+
+    //what the worker keeps for one frame with smoothing off, mapped the same way the component maps it
+    struct Frame {
+        explicit Frame(int w) : width(w), pixelDb((size_t)w * ANALYSER_TAPS) {
+            int stages = 0;
+            while (stages < MAX_DECIMATION_STAGES && sampleRate / (double)(2 << stages) >= LOW_BAND_MIN_RATE) {
+                ++stages;
+            }
+            const double lowSampleRate = sampleRate / (double)(1 << stages);
+            //same scalars as computeBinScalars
+            const float pScale = 4.0f / (float)FFT_SIZE;
+            const float tiltExponent = FFT_SLOPE / 6.0206f;
+            binScalars.resize(FFT_BIN_AMT);
+            for (int i = 0; i < FFT_BIN_AMT; ++i) {
+                const float scalar = std::pow((float)(i * sampleRate / FFT_SIZE) / MID_FREQ, tiltExponent) * pScale;
+                binScalars[i] = scalar * scalar;
+            }
+            const float lowBinMult = (float)(lowSampleRate / FFT_SIZE);
+            const int numLowBins = juce::jmin(FFT_BIN_AMT, (int)(MID_FREQ * ANALYSER_SMOOTH_REACH / lowBinMult) + 4);
+            lowBinScalars.resize(numLowBins);
+            for (int i = 0; i < numLowBins; ++i) {
+                const float scalar = std::pow((float)i * lowBinMult / MID_FREQ, tiltExponent) * pScale;
+                lowBinScalars[i] = scalar * scalar;
+            }
+            lowBinDb.resize(numLowBins);
+            //same split and spans as updatePixelFrequencyMapping
+            firstHighPixel = width;
+            for (int i = 0; i < width; ++i) {
+                if (freqRange.convertFrom0to1((float)i / (float)(width - 1)) > MID_FREQ) {
+                    firstHighPixel = i;
+                    break;
+                }
+            }
+            mapPixelSpans(spans, firstHighPixel, width, width, (float)(FFT_SIZE / sampleRate), FFT_BIN_AMT - 1, false);
+            mapPixelSpans(lowSpans, 0, firstHighPixel, width, (float)(FFT_SIZE / lowSampleRate), juce::jmax(0, numLowBins - 3), true);
+            for (auto& p : power) {
+                p.resize(FFT_BIN_AMT);
+            }
+            pixelPower.resize(juce::jmax(firstHighPixel, width - firstHighPixel));
+        }
+
+        //split, span averaging and one dB pass per band, the way drawNextFrameOfSpectrum and updateLowBand build a new frame of both
+        void build(const Spectrum& s) {
+            splitPackedSpectrum(s.full.data(), FFT_SIZE, binScalars.data(), FFT_BIN_AMT, power[0].data(), power[1].data());
+            for (int t = 0; t < ANALYSER_TAPS; ++t) {
+                buildSpanPixels(spans.data(), (int)spans.size(), power[t].data(), nullptr, pixelPower.data(),
+                                pixelDb.data() + t * width + firstHighPixel);
+            }
+            splitPackedSpectrum(s.low.data(), FFT_SIZE, lowBinScalars.data(), (int)lowBinScalars.size(), power[0].data(), power[1].data());
+            for (int t = 0; t < ANALYSER_TAPS; ++t) {
+                powerToDecibels(lowBinDb.data(), power[t].data(), (int)lowBinDb.size(), MIN_ANALYSIS_DB);
+                buildSpanPixels(lowSpans.data(), (int)lowSpans.size(), power[t].data(), lowBinDb.data(), pixelPower.data(),
+                                pixelDb.data() + t * width);
+            }
+        }
+
+        //same pixels with a log10 per rms pixel and four per cubic pixel, as the frame was built before the single dB pass
+        void buildReference(const Spectrum& s) {
+            splitPackedSpectrum(s.full.data(), FFT_SIZE, binScalars.data(), FFT_BIN_AMT, power[0].data(), power[1].data());
+            for (int t = 0; t < ANALYSER_TAPS; ++t) {
+                referencePixels(spans, power[t].data(), pixelDb.data() + t * width + firstHighPixel);
+            }
+            splitPackedSpectrum(s.low.data(), FFT_SIZE, lowBinScalars.data(), (int)lowBinScalars.size(), power[0].data(), power[1].data());
+            for (int t = 0; t < ANALYSER_TAPS; ++t) {
+                referencePixels(lowSpans, power[t].data(), pixelDb.data() + t * width);
+            }
+        }
+
+        static float toDb(float p) {
+            return juce::jmax(MIN_ANALYSIS_DB, 10.0f * std::log10(p));
+        }
+
+        static void referencePixels(const std::vector<PixelSpan>& pixelSpans, const float* p, float* dest) {
+            for (size_t i = 0; i < pixelSpans.size(); ++i) {
+                const auto& span = pixelSpans[i];
+                if (span.cubic) {
+                    dest[i] = cubicInterpolate(toDb(p[juce::jmax(0, span.lo - 1)]), toDb(p[span.lo]), toDb(p[span.lo + 1]),
+                                               toDb(p[span.lo + 2]), span.mu);
+                    continue;
+                }
+                float sum = 0.0f;
+                for (int b = span.lo; b <= span.hi; ++b) {
+                    sum += p[b];
+                }
+                dest[i] = toDb(sum / (float)(span.hi - span.lo + 1));
+            }
+        }
+
+        int width = 0;
+        int firstHighPixel = 0;
+        std::vector<float> binScalars, lowBinScalars, lowBinDb, pixelPower, pixelDb;
+        std::vector<float> power[ANALYSER_TAPS];
+        std::vector<PixelSpan> spans, lowSpans;
+    };
+};
+
+static AnalyserFrameTests analyserFrameTests;
@@ -0,0 +1,65 @@
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+
+//==============================================================================
+/** Editor open cost: constructs, paints one frame of, and destroys the editor against one processor, both cold (no other editor open,
+    so the shared look and feels, background, and analysis worker are made and freed every time) and warm (a second instance opening
+    while the first stays up)
+*/
+struct EditorTests : juce::UnitTest {
+    EditorTests() : juce::UnitTest("Editor", "Semi-Pro-Q") {}
+
+    static constexpr int benchmarkReps = 20;
+
+    void runTest() override {
+        SemiProQAudioProcessor processor;
+        processor.setRateAndBufferSizeDetails(48000.0, 512);
+
+        beginTest("Benchmark cold opens");
+        logMessage(describe(timeOpens(processor)));
+
+        beginTest("Benchmark warm opens");
+        {
+            //first instance stays open and keeps everything shared alive
+            auto first = std::make_unique<SemiProQAudioProcessorEditor>(processor);
+            logMessage(describe(timeOpens(processor)));
+        }
+    }
+
+private:
+    struct Timings {
+        double constructMs = 0.0, firstFrameMs = 0.0, destroyMs = 0.0;
+    };
+
+    Timings timeOpens(SemiProQAudioProcessor& processor) {
+        juce::PerformanceCounter constructCounter("construct", benchmarkReps + 1), frameCounter("first frame", benchmarkReps + 1),
+                                 destroyCounter("destroy", benchmarkReps + 1);
+        for (int r = 0; r < benchmarkReps; ++r) {
+            constructCounter.start();
+            auto editor = std::make_unique<SemiProQAudioProcessorEditor>(processor);
+            constructCounter.stop();
+            expect(editor->getWidth() > 0 && editor->getHeight() > 0);
+            //no window in a console app, so the first frame is painted into an image at the editor's size, children included
+            juce::Image frame(juce::Image::ARGB, editor->getWidth(), editor->getHeight(), true);
+            frameCounter.start();
+            {
+                juce::Graphics g(frame);
+                editor->paintEntireComponent(g, true);
+            }
+            frameCounter.stop();
+            destroyCounter.start();
+            editor.reset();
+            destroyCounter.stop();
+        }
+        return { constructCounter.getStatisticsAndReset().averageSeconds * 1000.0, frameCounter.getStatisticsAndReset().averageSeconds * 1000.0,
+                 destroyCounter.getStatisticsAndReset().averageSeconds * 1000.0 };
+    }
+
+    static juce::String describe(const Timings& t) {
+        return "construct " + juce::String(t.constructMs, 2) + " ms, first frame " + juce::String(t.firstFrameMs, 2) + " ms, destroy "
+               + juce::String(t.destroyMs, 2) + " ms";
+    }
+};
+
+static EditorTests editorTests;
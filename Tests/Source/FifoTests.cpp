@@ -0,0 +1,135 @@
+#include <JuceHeader.h>
+#include "Utils/Constants.h"
+#include "Utils/VisualizerProcesing.h"
+
+//==============================================================================
+/** Analyser fifo: processBlock writes its pre and post taps straight into the ring with beginFrames, writeTap and finishFrames
+*/
+struct FifoTests : juce::UnitTest {
+    FifoTests() : juce::UnitTest("Analyser Fifo", "Semi-Pro-Q") {}
+
+    void runTest() override {
+        beginTest("Mono and stereo (L + R) / 2 write the same frames");
+        {
+            //a 2048 value ring takes 1023 frames, so the second block of 700 wraps it
+            constexpr int capacity = 2048;
+            constexpr int blockSize = 700;
+            Fifo<float> monoFifo(capacity), stereoFifo(capacity);
+            std::vector<float> mono(blockSize), left(blockSize), right(blockSize);
+            std::vector<float> monoOut(blockSize * 2), stereoOut(blockSize * 2);
+            for (int block = 0; block < 3; ++block) {
+                //multiples of 1 / 64 well inside float's mantissa, so the stereo downmix is exact and has to match bit for bit
+                for (int i = 0; i < blockSize; ++i) {
+                    mono[i] = (float)((i * 37 + block * 11) % 512 - 256) / 64.0f;
+                    left[i] = mono[i] + 0.5f;
+                    right[i] = mono[i] - 0.5f;
+                }
+                //same order as processBlock: reserve, pre tap, the eq in place (a halving here), post tap, hand over
+                expectEquals(monoFifo.beginFrames(blockSize), blockSize);
+                expectEquals(stereoFifo.beginFrames(blockSize), blockSize);
+                monoFifo.writeTap(0, mono.data(), nullptr, ANALYSER_MID);
+                stereoFifo.writeTap(0, left.data(), right.data(), ANALYSER_MID);
+                for (int i = 0; i < blockSize; ++i) {
+                    mono[i] *= 0.5f;
+                    left[i] *= 0.5f;
+                    right[i] *= 0.5f;
+                }
+                monoFifo.writeTap(1, mono.data(), nullptr, ANALYSER_MID);
+                stereoFifo.writeTap(1, left.data(), right.data(), ANALYSER_MID);
+                //nothing is readable until the block is finished
+                expectEquals(monoFifo.getNumReady(), 0);
+                monoFifo.finishFrames();
+                stereoFifo.finishFrames();
+                expectEquals(monoFifo.getNumReady(), blockSize * 2);
+                expectEquals(stereoFifo.getNumReady(), monoFifo.getNumReady());
+
+                float* monoDest[] = { monoOut.data(), monoOut.data() + blockSize };
+                float* stereoDest[] = { stereoOut.data(), stereoOut.data() + blockSize };
+                expectEquals(monoFifo.popFrames(monoDest, blockSize, 2), blockSize);
+                expectEquals(stereoFifo.popFrames(stereoDest, blockSize, 2), blockSize);
+                int mismatches = 0;
+                for (int i = 0; i < blockSize; ++i) {
+                    mismatches += monoOut[i] != stereoOut[i] || monoOut[i] != mono[i] * 2.0f;
+                    mismatches += monoOut[blockSize + i] != stereoOut[blockSize + i] || monoOut[blockSize + i] != mono[i];
+                }
+                expectEquals(mismatches, 0, "block " + juce::String(block));
+            }
+        }
+
+        beginTest("Blocks longer than the prepared size reach the ring whole");
+        {
+            //sized like the processor's ring. nothing is sized by samplesPerBlock anymore, so a host going over its hint loses nothing
+            Fifo<float> fifo(FFT_RING_SIZE * ANALYSER_TAPS);
+            constexpr int hint = 512;
+            constexpr int blockSize = hint * 7 + 3;
+            std::vector<float> block(blockSize), pre(blockSize), post(blockSize);
+            for (int i = 0; i < blockSize; ++i) {
+                block[i] = (float)i;
+            }
+            expectEquals(fifo.beginFrames(blockSize), blockSize);
+            fifo.writeTap(0, block.data(), nullptr, ANALYSER_MID);
+            fifo.writeTap(1, block.data(), nullptr, ANALYSER_MID);
+            fifo.finishFrames();
+            expectEquals(fifo.getNumReady(), blockSize * 2);
+            float* dest[] = { pre.data(), post.data() };
+            expectEquals(fifo.popFrames(dest, blockSize, 2), blockSize);
+            expect(pre == block && post == block);
+
+            //only a full ring drops frames, and only the ones past its free space
+            const int freeFrames = (FFT_RING_SIZE * ANALYSER_TAPS - 1) / 2;
+            std::vector<float> big(freeFrames + hint, 1.0f);
+            expectEquals(fifo.beginFrames((int)big.size()), freeFrames);
+            fifo.writeTap(0, big.data(), nullptr, ANALYSER_MID);
+            fifo.writeTap(1, big.data(), nullptr, ANALYSER_MID);
+            fifo.finishFrames();
+            expectEquals(fifo.getNumReady(), freeFrames * 2);
+        }
+
+        beginTest("readWindow across the ring wrap matches a windowed linear copy");
+        {
+            //sized like the analyser's low band ring, a window plus a hop of both taps
+            constexpr int size = FFT_SIZE * ANALYSER_TAPS;
+            constexpr int hop = FFT_HOP_SIZE * ANALYSER_TAPS;
+            Fifo<float> fifo(size + hop);
+            std::vector<float> window(size), dest(size);
+            for (int i = 0; i < size; ++i) {
+                window[i] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * (float)(i / 2) / (float)FFT_SIZE);
+            }
+            //every value ever pushed, so each frame can be checked against a plain copy starting at the consumed offset
+            std::vector<float> history;
+            std::vector<float> a(FFT_HOP_SIZE), b(FFT_HOP_SIZE);
+            int consumed = 0;
+            int frames = 0;
+            //enough hops for the read and write positions to wrap the ring several times
+            for (int h = 0; h < FFT_HOP_AMT * 6; ++h) {
+                for (int i = 0; i < FFT_HOP_SIZE; ++i) {
+                    const int n = h * FFT_HOP_SIZE + i;
+                    a[i] = (float)(n % 1000);
+                    b[i] = (float)-(n % 777);
+                    history.push_back(a[i]);
+                    history.push_back(b[i]);
+                }
+                fifo.pushInterleaved(a.data(), b.data(), FFT_HOP_SIZE);
+                //a peek leaves everything in the ring
+                const int ready = fifo.getNumReady();
+                if (!fifo.readWindow(dest.data(), window.data(), size, 0)) {
+                    expectLessThan(ready, size);
+                    continue;
+                }
+                expectEquals(fifo.getNumReady(), ready);
+                expect(fifo.readWindow(dest.data(), window.data(), size, hop));
+                expectEquals(fifo.getNumReady(), ready - hop);
+                int mismatches = 0;
+                for (int i = 0; i < size; ++i) {
+                    mismatches += dest[i] != history[consumed + i] * window[i];
+                }
+                expectEquals(mismatches, 0, "frame " + juce::String(frames));
+                consumed += hop;
+                ++frames;
+            }
+            expectGreaterThan(frames, FFT_HOP_AMT * 4);
+        }
+    }
+};
+
+static FifoTests fifoTests;
@@ -0,0 +1,17 @@
+#include <JuceHeader.h>
+
+//==============================================================================
+/** Runs every registered UnitTest. The exit code is the number of failed expects, so a build script can gate on it
+*/
+int main() {
+    //the editor tests need a message manager, and whichever thread makes it is the message thread
+    juce::ScopedJuceInitialiser_GUI gui;
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+    runner.runAllTests();
+    int failures = 0;
+    for (int i = 0; i < runner.getNumResults(); ++i) {
+        failures += runner.getResult(i)->failures;
+    }
+    return failures;
+}
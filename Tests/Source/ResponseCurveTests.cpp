@@ -0,0 +1,111 @@
+#include <JuceHeader.h>
+#include "Utils/Constants.h"
+#include "Utils/AudioProcessing.h"
+#include "Utils/VisualizerProcesing.h"
+
+//==============================================================================
+/** Response curve evaluator: multiplyStageResponse's real arithmetic against the plain complex evaluation of the same biquads, plus a
+    per pixel benchmark of both at the widths the curve is drawn at
+*/
+struct ResponseCurveTests : juce::UnitTest {
+    ResponseCurveTests() : juce::UnitTest("Response Curve Evaluator", "Semi-Pro-Q") {}
+
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int numStages = 8;
+    static constexpr int benchmarkReps = 200;
+
+    void runTest() override {
+        //4 mixed peaks and a 48 dB/oct Butterworth highpass, same mix the benchmark was first run with
+        std::vector<std::array<float, COEFF_SIZE>> coeffs(numStages);
+        const float peakFreqs[] = { 60.0f, 400.0f, 2500.0f, 12000.0f };
+        const float peakQs[] = { 0.7f, 4.0f, 12.0f, 1.5f };
+        const float peakGains[] = { 6.0f, -12.0f, 9.0f, -3.0f };
+        for (int j = 0; j < 4; ++j) {
+            EqStage stage;
+            stage.makePeakFilter(sampleRate, peakFreqs[j], peakQs[j], juce::Decibels::decibelsToGain(peakGains[j]));
+            stage.readCoeffs(coeffs[j].data());
+        }
+        for (int j = 0; j < 4; ++j) {
+            EqStage stage;
+            stage.makeHighPass(sampleRate, 80.0f, getCascadeQ(3, j));
+            stage.readCoeffs(coeffs[4 + j].data());
+        }
+
+        for (int width : { 1200, 2400, 4800 }) {
+            beginTest("Matches the complex evaluation at " + juce::String(width) + " px");
+            Tables t(width);
+            evaluateReal(coeffs, t, true);
+            evaluateComplex(coeffs, t);
+            double maxDbDiff = 0.0, maxPhaseDiff = 0.0;
+            for (int i = 0; i < width; ++i) {
+                const double db = 10.0 * std::log10(t.mags[i]);
+                const double complexDb = 20.0 * std::log10(std::abs(t.response[i]));
+                maxDbDiff = juce::jmax(maxDbDiff, std::abs(db - complexDb));
+                maxPhaseDiff = juce::jmax(maxPhaseDiff, std::abs(std::remainder(t.phases[i] - std::arg(t.response[i]),
+                                                                                 juce::MathConstants<double>::twoPi)));
+            }
+            expectLessThan(maxDbDiff, 1.0e-9, "dB");
+            expectLessThan(maxPhaseDiff, 1.0e-9, "phase");
+
+            beginTest("Benchmark at " + juce::String(width) + " px");
+            juce::PerformanceCounter realCounter("real", benchmarkReps + 1), complexCounter("complex", benchmarkReps + 1);
+            for (int r = 0; r < benchmarkReps; ++r) {
+                realCounter.start();
+                evaluateReal(coeffs, t, false);
+                realCounter.stop();
+                complexCounter.start();
+                evaluateComplex(coeffs, t);
+                complexCounter.stop();
+            }
+            const auto realStats = realCounter.getStatisticsAndReset();
+            const auto complexStats = complexCounter.getStatisticsAndReset();
+            logMessage(juce::String(numStages) + " stages, complex " + juce::String(complexStats.averageSeconds * 1.0e6, 1) + " us, real "
+                       + juce::String(realStats.averageSeconds * 1.0e6, 1) + " us");
+        }
+    }
+
+private:
+    //per pixel tables over the log freq range, same as the curve had before it sampled adaptively
+    struct Tables {
+        explicit Tables(int width) : phi(width), sinW(width), w(width), mags(width), phases(width), delays(width), response(width) {
+            const auto range = logRange<double>(MIN_FREQ, MAX_FREQ);
+            for (int i = 0; i < width; ++i) {
+                const double f = range.convertFrom0to1((double)i / (double)(width - 1));
+                w[i] = juce::MathConstants<double>::twoPi * f / sampleRate;
+                const double s = std::sin(0.5 * w[i]);
+                phi[i] = s * s;
+                sinW[i] = std::sin(w[i]);
+            }
+        }
+
+        std::vector<double> phi, sinW, w, mags, phases, delays;
+        std::vector<std::complex<double>> response;
+    };
+
+    static void evaluateReal(const std::vector<std::array<float, COEFF_SIZE>>& coeffs, Tables& t, bool withPhase) {
+        const int num = (int)t.phi.size();
+        std::fill(t.mags.begin(), t.mags.end(), 1.0);
+        std::fill(t.phases.begin(), t.phases.end(), 0.0);
+        std::fill(t.delays.begin(), t.delays.end(), 0.0);
+        for (const auto& c : coeffs) {
+            multiplyStageResponse(c.data(), t.phi.data(), withPhase ? t.sinW.data() : nullptr, t.mags.data(), t.phases.data(),
+                                  t.delays.data(), num);
+        }
+    }
+
+    //B(z) / A(z) at z = e^(jw), one polar per point per stage
+    static void evaluateComplex(const std::vector<std::array<float, COEFF_SIZE>>& coeffs, Tables& t) {
+        const int num = (int)t.w.size();
+        for (int i = 0; i < num; ++i) {
+            const auto z1 = std::polar(1.0, -t.w[i]);
+            const auto z2 = z1 * z1;
+            std::complex<double> h(1.0, 0.0);
+            for (const auto& c : coeffs) {
+                h *= ((double)c[0] + (double)c[1] * z1 + (double)c[2] * z2) / (1.0 + (double)c[3] * z1 + (double)c[4] * z2);
+            }
+            t.response[i] = h;
+        }
+    }
+};
+
+static ResponseCurveTests responseCurveTests;